@@ -40,6 +40,9 @@ set(EN_AVX "1" CACHE STRING "AVX enabled.")
 # Build with support for ROCm (AMD GPUs)
 set(EN_GPU "0" CACHE STRING "AMD GPU enabled.")
 
+# Build with the event tracer (see cTrace); when disabled, tracing has no overhead
+set(EN_TRACE "0" CACHE STRING "Event tracing enabled.")
+
 ##############################
 #       BUILD CONFIG        #
 #############################
@@ -163,6 +166,10 @@ if(EN_AVX)
     set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -mavx")
 endif()
 
+if(EN_TRACE)
+    target_compile_definitions(Coyote PUBLIC EN_TRACE)
+endif()
+
 if(EN_GPU)
     target_compile_definitions(Coyote PUBLIC EN_GPU)
 
@@ -408,7 +408,8 @@ int setup_vfpga_devices(struct bus_driver_data *data) {
         int device_number = MKDEV(data->vfpga_major, i);
 
         sprintf(vf_dev_name_tmp, "%s_v%d", data->vfpga_dev_name, i);
-        device_create(data->vfpga_class, NULL, device_number, NULL, vf_dev_name_tmp, i);
+        // The PCI device is the parent, so that its NUMA node and local CPUs are exposed in sysfs (used for placement in cThread)
+        device_create(data->vfpga_class, &data->pci_dev->dev, device_number, NULL, vf_dev_name_tmp, i);
         dbg_info("virtual FPGA device %d created\n", i);
 
         cdev_init(&data->vfpga_dev[i].cdev, &vfpga_ops);
@@ -46,13 +46,15 @@
 
 // Note, how the Coyote thread is passed by reference; to avoid creating a copy of 
 // the thread object which can lead to undefined behaviour and bugs. 
-double run_bench(
+coyote::cBench run_bench(
     coyote::cThread &coyote_thread, coyote::localSg &src_sg, coyote::localSg &dst_sg, 
     int *src_mem, int *dst_mem, uint transfers, uint n_runs
 ) {
     // Initialise helper benchmarking class
-    // Used for keeping track of execution times & some helper functions (mean, P25, P75 etc.)
+    // Used for keeping track of execution times & some helper functions (mean, P25, P75, throughput etc.)
+    // Every iteration of the benchmark is one transfer, moving src_sg.len bytes
     coyote::cBench bench(n_runs);
+    bench.setWork(src_sg.len);
     
     // Randomly set the source data between -512 and +512; initialise destination memory to 0
     assert(src_sg.len == dst_sg.len);
@@ -68,27 +70,26 @@ double run_bench(
         coyote_thread.clearCompleted();
     };
 
-    // Execute benchmark
-    auto bench_fn = [&]() {
-        // Launch (queue) multiple transfers in parallel for throughput tests, or 1 in case of latency tests
-        // Recall, coyote_thread->invoke is asynchronous (can be made sync through different sgFlags)
-        for (int i = 0; i < transfers; i++) {
-            coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
-        }
+    // Launch (queue) a transfer; recall, coyote_thread->invoke is asynchronous (can be made sync through different sgFlags)
+    auto issue_fn = [&](unsigned int) {
+        coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+    };
 
-        // Wait until all of them are finished
-        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != transfers) {}
+    // Wait until the i-th transfer is finished; transfers complete in order, so the completion counter reaches i + 1
+    auto wait_fn = [&](unsigned int i) {
+        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) < i + 1) {}
     };
 
-    bench.execute(bench_fn, prep_fn);
+    // Execute benchmark: multiple transfers in parallel for throughput tests, or 1 in case of latency tests
+    bench.executeThroughput(transfers, transfers, issue_fn, wait_fn, prep_fn);
     
     // Make sure destination matches the source + 1 (the vFPGA logic in perf_local adds 1 to every 32-bit element, i.e. integer)
     for (int i = 0; i < src_sg.len / sizeof(int); i++) {
         assert(src_mem[i] + 1 == dst_mem[i]); 
     }
 
-    // Return average time taken for the data transfer
-    return bench.getAvg();
+    // Return the benchmark, holding the time taken for the data transfers
+    return bench;
 }
 
 int main(int argc, char *argv[])  {
@@ -130,12 +131,13 @@ int main(int argc, char *argv[])  {
         src_sg.len = curr_size; dst_sg.len = curr_size; 
 
         // Run throughput test
-        double throughput_time = run_bench(coyote_thread, src_sg, dst_sg, src_mem, dst_mem, N_THROUGHPUT_REPS, n_runs);
-        double throughput = ((double) N_THROUGHPUT_REPS * (double) curr_size) / (1024.0 * 1024.0 * throughput_time * 1e-9);
-        std::cout << "Average throughput: " << std::setw(8) << throughput << " MB/s; ";
+        // The throughput is given with its 95% confidence interval, obtained from the variation between the test runs
+        coyote::cBenchInterval throughput = run_bench(coyote_thread, src_sg, dst_sg, src_mem, dst_mem, N_THROUGHPUT_REPS, n_runs).getBytesPerSec();
+        std::cout << "Average throughput: " << std::setw(8) << throughput.avg / (1024.0 * 1024.0) << " MB/s ";
+        std::cout << "(" << throughput.lo / (1024.0 * 1024.0) << " - " << throughput.hi / (1024.0 * 1024.0) << "); ";
         
         // Run latency test
-        double latency_time = run_bench(coyote_thread, src_sg, dst_sg, src_mem, dst_mem, N_LATENCY_REPS, n_runs);
+        double latency_time = run_bench(coyote_thread, src_sg, dst_sg, src_mem, dst_mem, N_LATENCY_REPS, n_runs).getAvg();
         std::cout << "Average latency: " << std::setw(8) << latency_time / 1e3 << " us" << std::endl;
 
         // Update size and proceed to next iteration
@@ -27,9 +27,11 @@
 // Includes
 #include <chrono>
 #include <thread>
+#include <string>
 #include <iostream>
 #include <boost/program_options.hpp>
 
+#include "cSweep.hpp"
 #include "cThread.hpp"
 
 // Constants
@@ -59,7 +61,7 @@ enum class BenchmarkOperation: uint8_t {
 
 // Note, how the Coyote thread is passed by reference; to avoid creating a copy of 
 // the thread object which can lead to undefined behaviour and bugs. 
-double run_bench(
+coyote::cHistogram run_bench(
     coyote::cThread &coyote_thread, unsigned int size, int *mem, 
     unsigned int transfers, unsigned int n_runs, BenchmarkOperation oper
 ) {
@@ -88,27 +90,29 @@ double run_bench(
         return (double) coyote_thread.getCSR(static_cast<uint32_t>(BenchmarkRegisters::TIMER_REG)) * (double) CLOCK_PERIOD_NS;
     };
 
-    // Run benchmark
-    double avg_time = 0.0;
+    // Run benchmark; the times are measured by the vFPGA, so they're recorded directly rather than with cBench
+    coyote::cHistogram times;
     for(int j = 0; j < n_runs; j++) {
-        avg_time += benchmark_run();
+        times.record((uint64_t) benchmark_run());
     }
-    avg_time = avg_time / (double) n_runs;
     
-    return avg_time;
+    return times;
 }
 
 int main(int argc, char *argv[]) {
     // CLI arguments
     bool operation;
     unsigned int n_runs, min_size, max_size;
+    std::string output, baseline;
 
     boost::program_options::options_description runtime_options("Coyote Perf FPGA Options");
     runtime_options.add_options()
         ("operation,o", boost::program_options::value<bool>(&operation)->default_value(false), "Benchmark operation: READ(0) or WRITE(1)")
         ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(50), "Number of times to repeat the test")
         ("min_size,x", boost::program_options::value<unsigned int>(&min_size)->default_value(64), "Starting (minimum) transfer size")
-        ("max_size,X", boost::program_options::value<unsigned int>(&max_size)->default_value(4 * 1024 * 1024), "Ending (maximum) transfer size");
+        ("max_size,X", boost::program_options::value<unsigned int>(&max_size)->default_value(4 * 1024 * 1024), "Ending (maximum) transfer size")
+        ("output,f", boost::program_options::value<std::string>(&output), "File to write the results to (.csv or .json)")
+        ("baseline,b", boost::program_options::value<std::string>(&baseline), "Results of a previous run (.csv) to check for regressions");
     boost::program_options::variables_map command_line_arguments;
     boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
     boost::program_options::notify(command_line_arguments);
@@ -125,24 +129,38 @@ int main(int argc, char *argv[]) {
     int* mem =  (int *) coyote_thread.getMem({coyote::CoyoteAllocType::HPF, max_size});
     if (!mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
 
-    // Benchmark sweep
+    // Benchmark sweep; for every size, a throughput test (many transfers in flight), followed by a latency test (one transfer)
     HEADER("PERF FPGA");
-    unsigned int curr_size = min_size;
-    while(curr_size <= max_size) {
-        std::cout << "Size: " << std::setw(8) << curr_size << "; ";
-        
-        // Run throughput test
-        double throughput_time = run_bench(coyote_thread, curr_size, mem, N_THROUGHPUT_REPS, n_runs, oper);
-        double throughput = ((double) N_THROUGHPUT_REPS * (double) curr_size) / (1024.0 * 1024.0 * throughput_time * 1e-9);
-        std::cout << "Average throughput: " << std::setw(8) << throughput << " MB/s; ";
-        
-        // Run latency test
-        double latency_time = run_bench(coyote_thread, curr_size, mem, N_LATENCY_REPS, n_runs, oper);
-        std::cout << "Average latency: " << std::setw(8) << latency_time / 1e3 << " us" << std::endl;
+    coyote::cSweepGrid grid;
+    grid.sizes = coyote::cSweepGrid::powersOfTwo(min_size, max_size);
+    grid.opers = { operation ? "WRITE" : "READ" };
+    grid.queue_depths = { N_THROUGHPUT_REPS, N_LATENCY_REPS };
+    coyote::cSweep sweep("perf_fpga", grid);
+
+    for (const coyote::cSweepPoint &point : sweep.getPoints()) {
+        coyote::cHistogram times = run_bench(coyote_thread, point.size, mem, point.queue_depth, n_runs, oper);
+        sweep.add(point, times, (uint64_t) point.queue_depth * point.size, point.queue_depth);
+
+        if (point.queue_depth == N_THROUGHPUT_REPS) {
+            double throughput = sweep.getResults().back().bytes_per_sec.avg;
+            std::cout << "Size: " << std::setw(8) << point.size << "; ";
+            std::cout << "Average throughput: " << std::setw(8) << throughput / (1024.0 * 1024.0) << " MB/s; ";
+        } else {
+            std::cout << "Average latency: " << std::setw(8) << times.getMean() / 1e3 << " us" << std::endl;
+        }
+    }
 
-        // Update size and proceed to next iteration
-        curr_size *= 2;
+    // Machine-readable results and regression check, e.g., for nightly runs; a regression is reported with a non-zero exit code
+    if (!output.empty()) {
+        sweep.write(output);
     }
+    if (!baseline.empty()) {
+        HEADER("COMPARISON TO BASELINE");
+        if (coyote::cSweep::printComparison(sweep.compare(coyote::cSweep::readCsv(baseline)), std::cout)) {
+            return EXIT_FAILURE;
+        }
+    }
+
     return EXIT_SUCCESS;
 }
 
@@ -169,11 +169,14 @@ int main(int argc, char *argv[])  {
     };
 
     // Start throughput test
+    // Every iteration encrypts the text once per thread
     coyote::cBench bench(n_runs);
+    bench.setWork((uint64_t) size * n_threads, n_threads);
     HEADER("MULTI-THREADED AES ECB ENCRYPTION");
     bench.execute(benchmark_thr, prep_fn);
-    double throughput = ((double) size * (double) n_threads) / (1024.0 * 1024.0 * 1e-9 * bench.getAvg());
-    std::cout << "Average throughput: " << std::setw(8) << throughput << " MB/s; " << std::endl;
+    coyote::cBenchInterval throughput = bench.getBytesPerSec();
+    std::cout << "Average throughput: " << std::setw(8) << throughput.avg / (1024.0 * 1024.0) << " MB/s ";
+    std::cout << "(" << throughput.lo / (1024.0 * 1024.0) << " - " << throughput.hi / (1024.0 * 1024.0) << "); " << std::endl;
     
     // Since all the Coyote threads operate on the same text and have the same encryption key and IV
     // We can confirm that the encrypted text is the same for all the threads
@@ -31,7 +31,7 @@
 #include <boost/program_options.hpp>
 
 // Coyote-specific includes
-#include "cBench.hpp"
+#include "cSweep.hpp"
 #include "cThread.hpp"
 #include "constants.hpp"
 
@@ -39,7 +39,7 @@ constexpr bool const IS_CLIENT = true;
 
 // Note, how the Coyote thread is passed by reference; to avoid creating a copy of 
 // the thread object which can lead to undefined behaviour and bugs. 
-double run_bench(
+coyote::cBench run_bench(
     coyote::cThread &coyote_thread, coyote::rdmaSg &sg, 
     int *mem, uint transfers, uint n_runs, bool operation
 ) {
@@ -71,7 +71,10 @@ double run_bench(
     };
 
     // Execute benchmark
+    // For writes, the data is sent two ways (from client to server and then from server to client), so twice the work is done
+    // Reads are one way, so no need to scale
     coyote::cBench bench(n_runs, 0);
+    bench.setWork((1 + operation) * (uint64_t) transfers * sg.len, (1 + operation) * transfers);
     bench.execute(bench_fn, prep_fn);
 
     // Functional correctness check
@@ -80,16 +83,14 @@ double run_bench(
             assert(mem[i] == i);
         }
     }
-    
-    // For writes, divide by 2, since that is sent two ways (from client to server and then from server to client)
-    // Reads are one way, so no need to scale
-    return bench.getAvg() / (1. + (double) operation);
+
+    return bench;
 }
 
 int main(int argc, char *argv[])  {
     // CLI arguments
     bool operation;
-    std::string server_ip;
+    std::string server_ip, output, baseline;
     unsigned int min_size, max_size, n_runs;
 
     boost::program_options::options_description runtime_options("Coyote Perf RDMA Options");
@@ -98,7 +99,9 @@ int main(int argc, char *argv[])  {
         ("operation,o", boost::program_options::value<bool>(&operation)->default_value(false), "Benchmark operation: READ(0) or WRITE(1)")
         ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(N_RUNS_DEFAULT), "Number of times to repeat the test")
         ("min_size,x", boost::program_options::value<unsigned int>(&min_size)->default_value(MIN_TRANSFER_SIZE_DEFAULT), "Starting (minimum) transfer size")
-        ("max_size,X", boost::program_options::value<unsigned int>(&max_size)->default_value(MAX_TRANSFER_SIZE_DEFAULT), "Ending (maximum) transfer size");
+        ("max_size,X", boost::program_options::value<unsigned int>(&max_size)->default_value(MAX_TRANSFER_SIZE_DEFAULT), "Ending (maximum) transfer size")
+        ("output,f", boost::program_options::value<std::string>(&output), "File to write the results to (.csv or .json)")
+        ("baseline,b", boost::program_options::value<std::string>(&baseline), "Results of a previous run (.csv) to check for regressions");
     boost::program_options::variables_map command_line_arguments;
     boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
     boost::program_options::notify(command_line_arguments);
@@ -119,25 +122,40 @@ int main(int argc, char *argv[])  {
     int *mem = (int *) coyote_thread.initRDMA(max_size, coyote::DEF_PORT, server_ip.c_str());
     if (!mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
 
-    // Benchmark sweep of latency and throughput
+    // Benchmark sweep of latency and throughput; the server runs the same cells, in the same order (see getSweepGrid)
     HEADER("RDMA BENCHMARK: CLIENT");
-    unsigned int curr_size = min_size;
-    while(curr_size <= max_size) {
-        std::cout << "Size: " << std::setw(8) << curr_size << "; ";
-        
-        coyote::rdmaSg sg = { .len = curr_size };
-    
-        double throughput_time = run_bench(coyote_thread, sg, mem, N_THROUGHPUT_REPS, n_runs, operation);
-        double throughput = ((double) N_THROUGHPUT_REPS * (double) curr_size) / (1024.0 * 1024.0 * throughput_time * 1e-9);
-        std::cout << "Average throughput: " << std::setw(8) << throughput << " MB/s; ";
-        
-        double latency_time = run_bench(coyote_thread, sg, mem, N_LATENCY_REPS, n_runs, operation);
-        std::cout << "Average latency: " << std::setw(8) << latency_time / 1e3 << " us" << std::endl;
-
-        curr_size *= 2;
-    }
+    coyote::cSweep sweep("perf_rdma", getSweepGrid(min_size, max_size, operation));
+    sweep.run([&](const coyote::cSweepPoint &point) {
+        coyote::rdmaSg sg = { .len = point.size };
+        coyote::cBench bench = run_bench(coyote_thread, sg, mem, point.queue_depth, n_runs, operation);
+
+        if (point.queue_depth == N_THROUGHPUT_REPS) {
+            // The throughput is given with its 95% confidence interval, obtained from the variation between the test runs
+            coyote::cBenchInterval throughput = bench.getBytesPerSec();
+            std::cout << "Size: " << std::setw(8) << point.size << "; ";
+            std::cout << "Average throughput: " << std::setw(8) << throughput.avg / (1024.0 * 1024.0) << " MB/s ";
+            std::cout << "(" << throughput.lo / (1024.0 * 1024.0) << " - " << throughput.hi / (1024.0 * 1024.0) << "); ";
+        } else {
+            // For writes, divide by 2, since the latency is measured for a round-trip (ping-pong)
+            double latency_time = bench.getAvg() / (1. + (double) operation);
+            std::cout << "Average latency: " << std::setw(8) << latency_time / 1e3 << " us" << std::endl;
+        }
+        return bench;
+    });
 
     // Final sync and exit
     coyote_thread.connSync(IS_CLIENT);
+
+    // Machine-readable results and regression check, e.g., for nightly runs; a regression is reported with a non-zero exit code
+    if (!output.empty()) {
+        sweep.write(output);
+    }
+    if (!baseline.empty()) {
+        HEADER("COMPARISON TO BASELINE");
+        if (coyote::cSweep::printComparison(sweep.compare(coyote::cSweep::readCsv(baseline)), std::cout)) {
+            return EXIT_FAILURE;
+        }
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
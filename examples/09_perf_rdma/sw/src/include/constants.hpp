@@ -24,6 +24,8 @@
  * SOFTWARE.
  */
 
+#include "cSweep.hpp"
+
 // Constants shared by both client and server;
 // Placed in separate file to avoid any weird changes in one file not reflect in the other
 
@@ -39,3 +41,13 @@
 #define MIN_TRANSFER_SIZE_DEFAULT   64
 #define MAX_TRANSFER_SIZE_DEFAULT   (1 * 1024 * 1024)
 
+
+// Cells of the benchmark sweep; for every transfer size, a throughput test (N_THROUGHPUT_REPS transfers per run) 
+// followed by a latency test (N_LATENCY_REPS transfers per run). The client and server must run the same cells, in the same order
+inline coyote::cSweepGrid getSweepGrid(unsigned int min_size, unsigned int max_size, bool operation) {
+    coyote::cSweepGrid grid;
+    grid.sizes = coyote::cSweepGrid::powersOfTwo(min_size, max_size);
+    grid.opers = { operation ? "WRITE" : "READ" };
+    grid.queue_depths = { N_THROUGHPUT_REPS, N_LATENCY_REPS };
+    return grid;
+}
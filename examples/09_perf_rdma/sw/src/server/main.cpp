@@ -101,14 +101,11 @@ int main(int argc, char *argv[])  {
     int *mem = (int *) coyote_thread.initRDMA(max_size, coyote::DEF_PORT);
     if (!mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
 
-    // Benchmark sweep; exactly like done in the client code
+    // Benchmark sweep; exactly the same cells as in the client code
     HEADER("RDMA BENCHMARK: SERVER");
-    unsigned int curr_size = min_size;
-    while(curr_size <= max_size) {
-        coyote::rdmaSg sg = { .len = curr_size };
-        run_bench(coyote_thread, sg, mem, N_THROUGHPUT_REPS, n_runs, operation);
-        run_bench(coyote_thread, sg, mem, N_LATENCY_REPS, n_runs, operation);
-        curr_size *= 2;
+    for (const coyote::cSweepPoint &point : getSweepGrid(min_size, max_size, operation).getPoints()) {
+        coyote::rdmaSg sg = { .len = point.size };
+        run_bench(coyote_thread, sg, mem, point.queue_depth, n_runs, operation);
     }
 
     // Final sync and exit
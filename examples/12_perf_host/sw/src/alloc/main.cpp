@@ -0,0 +1,145 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory_resource>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cThread.hpp"
+#include "cBufferPool.hpp"
+#include "cMemResource.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Allocates n_allocs buffers of a given size and then frees them again, either directly with getMem/freeMem or from the pool
+void alloc_free(coyote::cThread &coyote_thread, coyote::cBufferPool *pool, unsigned int n_allocs, unsigned int size) {
+    std::vector<void *> buffers(n_allocs);
+    for (unsigned int i = 0; i < n_allocs; i++) {
+        buffers[i] = pool ? pool->alloc(size) : coyote_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+        if (!buffers[i]) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+    }
+    for (unsigned int i = 0; i < n_allocs; i++) {
+        if (pool) {
+            pool->free(buffers[i]);
+        } else {
+            coyote_thread.freeMem(buffers[i]);
+        }
+    }
+}
+
+// Returns the allocation rate (allocations + frees per second) with n_threads threads, each allocating and freeing n_allocs buffers n_rounds times
+double run_bench(coyote::cThread &coyote_thread, coyote::cBufferPool *pool, unsigned int n_threads, unsigned int n_rounds, unsigned int n_allocs, unsigned int size) {
+    auto begin_time = std::chrono::high_resolution_clock::now();
+    
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < n_threads; t++) {
+        workers.emplace_back([&]() {
+            for (unsigned int r = 0; r < n_rounds; r++) {
+                alloc_free(coyote_thread, pool, n_allocs, size);
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count() * 1e-9;
+    return (double) n_threads * (double) n_rounds * (double) n_allocs / time;
+}
+
+// Returns the allocation rate of containers (std::pmr::vector) from a cMemResource, each allocating and freeing n_allocs vectors n_rounds times
+double run_bench_pmr(coyote::cMemResource &resource, unsigned int n_rounds, unsigned int n_allocs, unsigned int size) {
+    auto begin_time = std::chrono::high_resolution_clock::now();
+
+    for (unsigned int r = 0; r < n_rounds; r++) {
+        std::vector<std::pmr::vector<float>> vectors;
+        vectors.reserve(n_allocs);
+        for (unsigned int i = 0; i < n_allocs; i++) {
+            vectors.emplace_back(size / sizeof(float), &resource);
+        }
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count() * 1e-9;
+    return (double) n_rounds * (double) n_allocs / time;
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_rounds, n_allocs, n_threads;
+
+    boost::program_options::options_description runtime_options("Coyote Buffer Pool Options");
+    runtime_options.add_options()
+        ("rounds,r", boost::program_options::value<unsigned int>(&n_rounds)->default_value(100), "Number of allocate-free rounds")
+        ("allocs,n", boost::program_options::value<unsigned int>(&n_allocs)->default_value(16), "Number of buffers allocated in every round")
+        ("threads,t", boost::program_options::value<unsigned int>(&n_threads)->default_value(4), "Number of threads for the multi-threaded pool test");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of rounds: " << n_rounds << std::endl;
+    std::cout << "Buffers per round: " << n_allocs << std::endl;
+    std::cout << "Number of threads: " << n_threads << std::endl << std::endl;
+
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    coyote::cBufferPool pool(coyote_thread);
+    coyote::cMemResource resource(coyote_thread);
+
+    // Reserve the regions upfront (one slab per 2 MB buffer, plus the slabs for the smaller sizes), 
+    // so that the measurements don't include the driver calls for reserving the regions
+    pool.reserve((uint64_t) (n_threads * n_allocs + 2) * coyote::BPOOL_SLAB_SIZE);
+    resource.getPool().reserve((uint64_t) (n_allocs + 2) * coyote::BPOOL_SLAB_SIZE);
+
+    HEADER("PERF HOST: BUFFER POOL");
+    for (unsigned int size : {4096u, 65536u, coyote::BPOOL_SLAB_SIZE}) {
+        std::cout << "Buffer size: " << std::setw(8) << size << std::endl;
+        
+        // getMem/freeMem can't be called concurrently on the same cThread, so the baseline is single-threaded
+        double rate_direct = run_bench(coyote_thread, nullptr, 1, n_rounds, n_allocs, size);
+        double rate_pool = run_bench(coyote_thread, &pool, 1, n_rounds, n_allocs, size);
+        double rate_pool_mt = run_bench(coyote_thread, &pool, n_threads, n_rounds, n_allocs, size);
+        double rate_pmr = run_bench_pmr(resource, n_rounds, n_allocs, size);
+
+        std::cout << "getMem/freeMem:            " << std::setw(12) << rate_direct / 1e6 << " M allocations/s" << std::endl;
+        std::cout << "cBufferPool (1 thread):    " << std::setw(12) << rate_pool / 1e6 << " M allocations/s" << std::endl;
+        std::cout << "cBufferPool (" << n_threads << " threads):   " << std::setw(12) << rate_pool_mt / 1e6 << " M allocations/s" << std::endl;
+        std::cout << "std::pmr::vector:          " << std::setw(12) << rate_pmr / 1e6 << " M allocations/s" << std::endl;
+    }
+
+    coyote::cBufferPoolStats stats = pool.getStats();
+    std::cout << std::endl << "Pool: " << stats.n_regions << " regions (" << stats.reserved_bytes / (1024 * 1024) << " MB), " << stats.n_slabs << " slabs" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <sys/resource.h>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Returns the CPU time (user + system) consumed by the entire process so far, in seconds
+double get_cpu_time() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (double) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + 
+           (double) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+// Ways of waiting for a transfer to complete
+enum class WaitMode { POLL, ASYNC, BLOCK };
+
+// Every application thread owns one Coyote thread and issues n_transfers transfers, one at a time
+// In the polling mode, it spins on checkCompleted(); in the async mode, it blocks on the future, 
+// while the completions of all the Coyote threads are detected by the (single) cReactor thread;
+// in the blocking mode, it spins briefly and then sleeps in waitCompleted()
+void run_worker(coyote::cThread *coyote_thread, coyote::localSg src_sg, coyote::localSg dst_sg, unsigned int n_transfers, WaitMode mode) {
+    for (unsigned int i = 0; i < n_transfers; i++) {
+        if (mode == WaitMode::ASYNC) {
+            coyote_thread->invokeAsync(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg).wait();
+        } else if (mode == WaitMode::BLOCK) {
+            coyote_thread->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+            coyote_thread->waitCompleted(coyote::CoyoteOper::LOCAL_TRANSFER, i + 1);
+        } else {
+            coyote_thread->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+            while (coyote_thread->checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != i + 1) {}
+        }
+    }
+}
+
+void run_bench(
+    std::vector<std::unique_ptr<coyote::cThread>> &coyote_threads, std::vector<std::pair<coyote::localSg, coyote::localSg>> &sg_list, 
+    unsigned int n_transfers, WaitMode mode
+) {
+    for (auto &coyote_thread : coyote_threads) {
+        coyote_thread->clearCompleted();
+    }
+
+    double cpu_begin = get_cpu_time();
+    auto begin_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < coyote_threads.size(); i++) {
+        workers.emplace_back(run_worker, coyote_threads[i].get(), sg_list[i].first, sg_list[i].second, n_transfers, mode);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double cpu_time = get_cpu_time() - cpu_begin;
+    double wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count() * 1e-9;
+
+    double n_total = (double) n_transfers * (double) coyote_threads.size();
+    std::cout << (mode == WaitMode::ASYNC ? "invokeAsync + wait: " : mode == WaitMode::BLOCK ? "waitCompleted:      " : "checkCompleted:     ");
+    std::cout << "Throughput: " << std::setw(8) << n_total / wall_time / 1e6 << " M transfers/s; ";
+    std::cout << "CPU cores used: " << std::setw(6) << cpu_time / wall_time << std::endl;
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_threads, n_transfers, size;
+
+    boost::program_options::options_description runtime_options("Coyote Asynchronous Completion Options");
+    runtime_options.add_options()
+        ("threads,t", boost::program_options::value<unsigned int>(&n_threads)->default_value(16), "Number of Coyote threads (each with its own application thread)")
+        ("transfers,n", boost::program_options::value<unsigned int>(&n_transfers)->default_value(10000), "Number of transfers per thread")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(4096), "Transfer size");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of Coyote threads: " << n_threads << std::endl;
+    std::cout << "Transfers per thread: " << n_transfers << std::endl;
+    std::cout << "Transfer size: " << size << std::endl << std::endl;
+
+    // All the Coyote threads target the same vFPGA (and the same stream), each with its own buffers
+    std::vector<std::unique_ptr<coyote::cThread>> coyote_threads;
+    std::vector<std::pair<coyote::localSg, coyote::localSg>> sg_list;
+    for (unsigned int i = 0; i < n_threads; i++) {
+        coyote_threads.emplace_back(new coyote::cThread(DEFAULT_VFPGA_ID, getpid()));
+        void *src_mem = coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, size});
+        void *dst_mem = coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, size});
+        if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+
+        coyote::localSg src_sg = { .addr = src_mem, .len = size };
+        coyote::localSg dst_sg = { .addr = dst_mem, .len = size };
+        sg_list.emplace_back(std::make_pair(src_sg, dst_sg));
+    }
+
+    HEADER("PERF HOST: SHARED COMPLETION REACTOR");
+    run_bench(coyote_threads, sg_list, n_transfers, WaitMode::POLL);
+    run_bench(coyote_threads, sg_list, n_transfers, WaitMode::ASYNC);
+    run_bench(coyote_threads, sg_list, n_transfers, WaitMode::BLOCK);
+
+    // How often the blocking waits had to sleep and how long the final sleep took (an upper bound on the added latency)
+    coyote::cmplWaitStats wait_stats;
+    for (auto &coyote_thread : coyote_threads) {
+        coyote::cmplWaitStats thread_stats = coyote_thread->getWaitStats();
+        wait_stats.n_waits += thread_stats.n_waits;
+        wait_stats.n_sleeps += thread_stats.n_sleeps;
+        wait_stats.final_sleep_ns += thread_stats.final_sleep_ns;
+        wait_stats.max_final_sleep_ns = std::max(wait_stats.max_final_sleep_ns, thread_stats.max_final_sleep_ns);
+    }
+    std::cout << std::endl << "waitCompleted: " << wait_stats.n_sleeps << " of " << wait_stats.n_waits << " waits slept; ";
+    std::cout << "average final sleep: " << (wait_stats.n_sleeps ? wait_stats.final_sleep_ns / wait_stats.n_sleeps : 0) << " ns, ";
+    std::cout << "maximum: " << wait_stats.max_final_sleep_ns << " ns" << std::endl;
+
+    // When compiled with the event tracer, write the timeline of all three modes; open it in chrome://tracing or Perfetto
+    #ifdef EN_TRACE
+    coyote::cTrace::getInstance().writeChrome("async_trace.json");
+    std::cout << "Trace written to async_trace.json" << std::endl;
+    #endif
+
+    return EXIT_SUCCESS;
+}
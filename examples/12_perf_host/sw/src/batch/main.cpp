@@ -0,0 +1,158 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Number of descriptors (commands) issued in every test run; must be a multiple of the largest batch size
+#define N_DESCRIPTORS 1024
+
+using sg_pair = std::pair<coyote::localSg, coyote::localSg>;
+
+// Note, how the Coyote thread is passed by reference; to avoid creating a copy of 
+// the thread object which can lead to undefined behaviour and bugs. 
+void run_bench(
+    coyote::cThread &coyote_thread, std::vector<sg_pair> &sg_list, 
+    unsigned int batch_size, unsigned int n_runs, bool batched, bool perf
+) {
+    // Number of batches per test run; since only the final command of every batch is flagged as last
+    // the completion counter is incremented once per batch
+    unsigned int n_batches = sg_list.size() / batch_size;
+    std::vector<std::vector<sg_pair>> batches(n_batches);
+    for (unsigned int i = 0; i < n_batches; i++) {
+        batches[i] = std::vector<sg_pair>(sg_list.begin() + i * batch_size, sg_list.begin() + (i + 1) * batch_size);
+    }
+
+    // Time spent in submitting the commands, excluding the wait for completion
+    double submit_time = 0;
+
+    auto prep_fn = [&]() {
+        coyote_thread.clearCompleted();
+    };
+
+    auto bench_fn = [&]() {
+        auto begin_time = std::chrono::high_resolution_clock::now();
+        for (unsigned int i = 0; i < n_batches; i++) {
+            if (batched) {
+                coyote_thread.invokeBatch(coyote::CoyoteOper::LOCAL_TRANSFER, batches[i]);
+            } else {
+                for (unsigned int j = 0; j < batch_size; j++) {
+                    coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, batches[i][j].first, batches[i][j].second, j == batch_size - 1);
+                }
+            }
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        submit_time += std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count();
+
+        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != n_batches) {}
+    };
+
+    coyote::cBench bench(n_runs, 0);
+    bench.setPerfCounters(perf);
+    bench.execute(bench_fn, prep_fn);
+
+    double n_descs = (double) sg_list.size();
+    std::cout << (batched ? "invokeBatch: " : "invoke:      ");
+    std::cout << "Submission: " << std::setw(8) << (n_descs * n_runs) / (submit_time * 1e-9) / 1e6 << " M descriptors/s; ";
+    std::cout << "End-to-end: " << std::setw(8) << n_descs / (bench.getAvg() * 1e-9) / 1e6 << " M descriptors/s" << std::endl;
+
+    // Host-side costs per descriptor, e.g., cache misses in the polling loop on the completion counter; n/a if the event can't be counted
+    if (perf) {
+        auto per_desc = [&](coyote::cPerfEvent event) { return bench.getPerfCounter(event) / n_descs; };
+        std::cout << "             per descriptor: " << per_desc(coyote::cPerfEvent::CYCLES) << " cycles, "
+                  << per_desc(coyote::cPerfEvent::INSTRUCTIONS) << " instructions, "
+                  << per_desc(coyote::cPerfEvent::LLC_MISSES) << " LLC misses, "
+                  << per_desc(coyote::cPerfEvent::DTLB_MISSES) << " dTLB misses; per run: "
+                  << bench.getPerfCounter(coyote::cPerfEvent::CONTEXT_SWITCHES) << " context switches" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs, size, max_batch;
+    bool perf;
+
+    boost::program_options::options_description runtime_options("Coyote Batched Submission Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(100), "Number of times to repeat the test")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(64), "Transfer size of every descriptor")
+        ("max_batch,b", boost::program_options::value<unsigned int>(&max_batch)->default_value(256), "Ending (maximum) batch size")
+        ("perf,p", boost::program_options::value<bool>(&perf)->default_value(false), "Capture the CPU's performance counters (cycles, cache and TLB misses etc.)");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    if (N_DESCRIPTORS % max_batch) {
+        throw std::runtime_error("Maximum batch size must divide the number of descriptors per run; exiting...");
+    }
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Transfer size: " << size << std::endl;
+    std::cout << "Descriptors per run: " << N_DESCRIPTORS << std::endl;
+    std::cout << "Ending batch size: " << max_batch << std::endl;
+    std::cout << "Performance counters: " << (perf ? "enabled" : "disabled") << std::endl << std::endl;
+
+    // Create Coyote thread and allocate source & destination memory; every descriptor operates on a different part of the buffers
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    char *src_mem = (char *) coyote_thread.getMem({coyote::CoyoteAllocType::HPF, N_DESCRIPTORS * size});
+    char *dst_mem = (char *) coyote_thread.getMem({coyote::CoyoteAllocType::HPF, N_DESCRIPTORS * size});
+    if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+
+    std::vector<sg_pair> sg_list;
+    for (unsigned int i = 0; i < N_DESCRIPTORS; i++) {
+        coyote::localSg src_sg = { .addr = src_mem + i * size, .len = size };
+        coyote::localSg dst_sg = { .addr = dst_mem + i * size, .len = size };
+        sg_list.emplace_back(std::make_pair(src_sg, dst_sg));
+    }
+
+    // Benchmark sweep: compare per-command invoke with batched submission for increasing batch sizes
+    HEADER("PERF HOST: BATCHED SUBMISSION");
+    unsigned int curr_batch = 1;
+    while (curr_batch <= max_batch) {
+        std::cout << "Batch size: " << std::setw(4) << curr_batch << std::endl;
+        run_bench(coyote_thread, sg_list, curr_batch, n_runs, false, perf);
+        run_bench(coyote_thread, sg_list, curr_batch, n_runs, true, perf);
+        curr_batch *= 2;
+    }
+
+    // Host-side statistics, e.g., to see how often command submission stalled on a full command FIFO
+    HEADER("HOST-SIDE STATISTICS");
+    std::cout << coyote::toJson(coyote_thread.getStats()) << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs, size_mb, min_chunk, max_chunk;
+
+    boost::program_options::options_description runtime_options("Coyote Transfer Splitting Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(10), "Number of times to repeat the test")
+        ("size,s", boost::program_options::value<unsigned int>(&size_mb)->default_value(1024), "Size of the (single) transfer, in MB")
+        ("min_chunk,x", boost::program_options::value<unsigned int>(&min_chunk)->default_value(1), "Starting (minimum) chunk size, in MB")
+        ("max_chunk,X", boost::program_options::value<unsigned int>(&max_chunk)->default_value(128), "Ending (maximum) chunk size, in MB");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    if (size_mb >= 4096) {
+        throw std::runtime_error("Transfer size must be less than 4 GB; exiting...");
+    }
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Transfer size [MB]: " << size_mb << std::endl;
+    std::cout << "Starting chunk size [MB]: " << min_chunk << std::endl;
+    std::cout << "Ending chunk size [MB]: " << max_chunk << std::endl << std::endl;
+
+    // A single, large buffer for the source and destination; the transfer is split into chunks by invoke
+    uint32_t size = size_mb * 1024 * 1024;
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    void *src_mem = coyote_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+    void *dst_mem = coyote_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+    if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+
+    coyote::localSg src_sg = { .addr = src_mem, .len = size };
+    coyote::localSg dst_sg = { .addr = dst_mem, .len = size };
+
+    HEADER("PERF HOST: TRANSFER SPLITTING");
+    unsigned int curr_chunk = min_chunk;
+    while (curr_chunk <= max_chunk) {
+        coyote_thread.setChunkSize(curr_chunk * 1024 * 1024);
+
+        auto prep_fn = [&]() {
+            coyote_thread.clearCompleted();
+        };
+
+        // The whole transfer is counted as a single completion, regardless of the number of chunks
+        auto bench_fn = [&]() {
+            coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+            while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != 1) {}
+        };
+
+        coyote::cBench bench(n_runs, 1);
+        bench.execute(bench_fn, prep_fn);
+
+        std::cout << "Chunk size [MB]: " << std::setw(4) << curr_chunk << "; ";
+        std::cout << "Throughput: " << std::setw(8) << (double) size / (1024.0 * 1024.0 * 1e-9 * bench.getAvg()) << " MB/s" << std::endl;
+        curr_chunk *= 2;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes; NOTE: cCoro.hpp requires C++20, see the CMakeLists.txt for this benchmark
+#include "cCoro.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+using sg_pair = std::pair<coyote::localSg, coyote::localSg>;
+
+// Blocking pattern, as in Example 8: in every round, every pipeline of every Coyote thread issues one transfer,
+// and then the (single) application thread spins until all the Coyote threads have completed their transfers
+void run_blocking(
+    std::vector<std::unique_ptr<coyote::cThread>> &coyote_threads, std::vector<std::vector<sg_pair>> &sg_lists, unsigned int n_transfers
+) {
+    for (unsigned int r = 0; r < n_transfers; r++) {
+        for (unsigned int i = 0; i < coyote_threads.size(); i++) {
+            for (auto &sg : sg_lists[i]) {
+                coyote_threads[i]->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, sg.first, sg.second);
+            }
+        }
+
+        bool k = false;
+        while (!k) {
+            k = true;
+            for (unsigned int i = 0; i < coyote_threads.size(); i++) {
+                if (coyote_threads[i]->checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != (r + 1) * sg_lists[i].size()) k = false;
+            }
+        }
+    }
+}
+
+// Every pipeline is a coroutine, issuing its transfers one after the other; a pipeline only waits 
+// for its own transfer, while the executor interleaves all the pipelines on the calling thread
+coyote::cCoroTask pipeline(coyote::cThread &coyote_thread, sg_pair sg, unsigned int n_transfers) {
+    for (unsigned int r = 0; r < n_transfers; r++) {
+        co_await coyote::transfer(coyote_thread, sg.first, sg.second);
+    }
+}
+
+void run_coro(
+    std::vector<std::unique_ptr<coyote::cThread>> &coyote_threads, std::vector<std::vector<sg_pair>> &sg_lists, unsigned int n_transfers
+) {
+    coyote::cExecutor executor;
+    for (unsigned int i = 0; i < coyote_threads.size(); i++) {
+        for (auto &sg : sg_lists[i]) {
+            executor.spawn(pipeline(*coyote_threads[i], sg, n_transfers));
+        }
+    }
+    executor.run();
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_threads, n_pipelines, n_transfers, size;
+
+    boost::program_options::options_description runtime_options("Coyote Coroutine Options");
+    runtime_options.add_options()
+        ("threads,t", boost::program_options::value<unsigned int>(&n_threads)->default_value(4), "Number of Coyote threads")
+        ("pipelines,p", boost::program_options::value<unsigned int>(&n_pipelines)->default_value(8), "Number of independent pipelines per Coyote thread")
+        ("transfers,n", boost::program_options::value<unsigned int>(&n_transfers)->default_value(1000), "Number of transfers per pipeline")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(4096), "Transfer size");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of Coyote threads: " << n_threads << std::endl;
+    std::cout << "Pipelines per thread: " << n_pipelines << std::endl;
+    std::cout << "Transfers per pipeline: " << n_transfers << std::endl;
+    std::cout << "Transfer size: " << size << std::endl << std::endl;
+
+    // Every pipeline has its own source and destination buffers
+    std::vector<std::unique_ptr<coyote::cThread>> coyote_threads;
+    std::vector<std::vector<sg_pair>> sg_lists(n_threads);
+    for (unsigned int i = 0; i < n_threads; i++) {
+        coyote_threads.emplace_back(new coyote::cThread(DEFAULT_VFPGA_ID, getpid()));
+        char *src_mem = (char *) coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, n_pipelines * size});
+        char *dst_mem = (char *) coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, n_pipelines * size});
+        if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+
+        for (unsigned int j = 0; j < n_pipelines; j++) {
+            coyote::localSg src_sg = { .addr = src_mem + j * size, .len = size };
+            coyote::localSg dst_sg = { .addr = dst_mem + j * size, .len = size };
+            sg_lists[i].emplace_back(std::make_pair(src_sg, dst_sg));
+        }
+    }
+
+    HEADER("PERF HOST: COROUTINES");
+    double n_total = (double) n_threads * (double) n_pipelines * (double) n_transfers;
+    for (bool coro : {false, true}) {
+        for (auto &coyote_thread : coyote_threads) {
+            coyote_thread->clearCompleted();
+        }
+
+        auto begin_time = std::chrono::high_resolution_clock::now();
+        if (coro) {
+            run_coro(coyote_threads, sg_lists, n_transfers);
+        } else {
+            run_blocking(coyote_threads, sg_lists, n_transfers);
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        double time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count() * 1e-9;
+
+        std::cout << (coro ? "Coroutines: " : "Blocking:   ");
+        std::cout << "Throughput: " << std::setw(8) << n_total / time / 1e6 << " M transfers/s, ";
+        std::cout << std::setw(8) << n_total * size / time / (1024.0 * 1024.0) << " MB/s" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
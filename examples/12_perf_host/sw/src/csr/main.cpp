@@ -0,0 +1,111 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// The register parser of Example 7 decodes 16 registers, but only implements the first 8; 
+// writes to registers 8-15 are ignored, so they can be used to measure the cost of the writes alone
+#define FIRST_FREE_REG 8
+#define MAX_REGS 8
+
+// A kernel launch, as seen from the host: all the arguments are written to the vFPGA, followed by
+// a read from a register; since writes are posted, the read only returns once the writes have arrived
+void run_bench(coyote::cThread &coyote_thread, unsigned int n_regs, unsigned int n_runs, bool bulk) {
+    std::vector<uint64_t> vals(n_regs);
+    for (unsigned int i = 0; i < n_regs; i++) {
+        vals[i] = i;
+    }
+
+    auto bench_fn = [&]() {
+        if (bulk) {
+            coyote_thread.setCSRs(FIRST_FREE_REG, vals);
+        } else {
+            for (unsigned int i = 0; i < n_regs; i++) {
+                coyote_thread.setCSR(vals[i], FIRST_FREE_REG + i);
+            }
+        }
+        coyote_thread.getCSR(FIRST_FREE_REG);
+    };
+
+    auto read_fn = [&]() {
+        if (bulk) {
+            coyote_thread.getCSRs(FIRST_FREE_REG, vals.data(), n_regs);
+        } else {
+            for (unsigned int i = 0; i < n_regs; i++) {
+                vals[i] = coyote_thread.getCSR(FIRST_FREE_REG + i);
+            }
+        }
+    };
+
+    auto prep_fn = [&]() {};
+
+    coyote::cBench bench(n_runs);
+    bench.execute(bench_fn, prep_fn);
+    double launch_time = bench.getAvg();
+    bench.execute(read_fn, prep_fn);
+    double read_time = bench.getAvg();
+
+    std::cout << std::setw(4) << n_regs << (bulk ? "  setCSRs/getCSRs: " : "  setCSR/getCSR:   ");
+    std::cout << "launch: " << std::setw(8) << launch_time << " ns; read: " << std::setw(8) << read_time << " ns" << std::endl;
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs;
+
+    boost::program_options::options_description runtime_options("Coyote CSR Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(10000), "Number of times to repeat the test");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Timer overhead (subtracted): " << coyote::cTimer::toNs(coyote::cTimer::getOverhead()) << " ns" << std::endl << std::endl;
+
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+
+    HEADER("PERF HOST: CONTROL REGISTERS");
+    for (unsigned int n_regs = 1; n_regs <= MAX_REGS; n_regs *= 2) {
+        run_bench(coyote_thread, n_regs, n_runs, false);
+        run_bench(coyote_thread, n_regs, n_runs, true);
+    }
+
+    return EXIT_SUCCESS;
+}
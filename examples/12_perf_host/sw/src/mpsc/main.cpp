@@ -0,0 +1,160 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <mutex>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Ways of sharing the vFPGA between the application threads
+enum class ShareMode { PRIVATE, MUTEX, MPSC };
+
+// Every application thread issues n_rounds rounds of n_inflight transfers and waits for the final transfer of each round
+// In the private mode, every thread uses its own cThread; otherwise, all the threads share the first cThread, 
+// protected by a mutex or using the multi-producer submission queue
+void run_worker(
+    coyote::cThread *coyote_thread, std::mutex *mtx, coyote::localSg src_sg, coyote::localSg dst_sg, 
+    unsigned int n_rounds, unsigned int n_inflight
+) {
+    for (unsigned int r = 0; r < n_rounds; r++) {
+        coyote::cmplToken token = coyote::CMPL_TOKEN_NONE;
+        for (unsigned int i = 0; i < n_inflight; i++) {
+            if (mtx) {
+                std::lock_guard<std::mutex> lock(*mtx);
+                token = coyote_thread->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+            } else {
+                token = coyote_thread->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+            }
+        }
+
+        while (true) {
+            if (mtx) {
+                std::lock_guard<std::mutex> lock(*mtx);
+                if (coyote_thread->isCompleted(token)) { break; }
+            } else if (coyote_thread->isCompleted(token)) {
+                break;
+            }
+        }
+    }
+}
+
+void run_bench(
+    std::vector<std::unique_ptr<coyote::cThread>> &coyote_threads, std::vector<std::pair<coyote::localSg, coyote::localSg>> &sg_list, 
+    unsigned int n_rounds, unsigned int n_inflight, ShareMode mode
+) {
+    for (auto &coyote_thread : coyote_threads) {
+        coyote_thread->clearCompleted();
+    }
+    coyote_threads[0]->setMultiProducer(mode == ShareMode::MPSC);
+
+    std::mutex mtx;
+    auto begin_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < sg_list.size(); i++) {
+        coyote::cThread *coyote_thread = mode == ShareMode::PRIVATE ? coyote_threads[i].get() : coyote_threads[0].get();
+        workers.emplace_back(
+            run_worker, coyote_thread, mode == ShareMode::MUTEX ? &mtx : nullptr, 
+            sg_list[i].first, sg_list[i].second, n_rounds, n_inflight
+        );
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count() * 1e-9;
+
+    double n_total = (double) n_rounds * (double) n_inflight * (double) sg_list.size();
+    std::cout << (mode == ShareMode::PRIVATE ? "cThread per thread:        " : mode == ShareMode::MUTEX ? "Shared cThread, mutex:     " : "Shared cThread, MPSC:      ");
+    std::cout << std::setw(10) << n_total / time / 1e6 << " M transfers/s" << std::endl;
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_threads, n_rounds, n_inflight, size;
+
+    boost::program_options::options_description runtime_options("Coyote Multi-producer Submission Options");
+    runtime_options.add_options()
+        ("threads,t", boost::program_options::value<unsigned int>(&n_threads)->default_value(8), "Number of application threads")
+        ("rounds,r", boost::program_options::value<unsigned int>(&n_rounds)->default_value(10000), "Number of rounds per thread")
+        ("inflight,n", boost::program_options::value<unsigned int>(&n_inflight)->default_value(4), "Number of transfers in flight per thread, in every round")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(4096), "Transfer size");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of application threads: " << n_threads << std::endl;
+    std::cout << "Rounds per thread: " << n_rounds << std::endl;
+    std::cout << "Transfers in flight per thread: " << n_inflight << std::endl;
+    std::cout << "Transfer size: " << size << std::endl << std::endl;
+
+    // One cThread per application thread, for the baseline; every thread has its own buffers, mapped in every cThread
+    std::vector<std::unique_ptr<coyote::cThread>> coyote_threads;
+    for (unsigned int i = 0; i < n_threads; i++) {
+        coyote_threads.emplace_back(new coyote::cThread(DEFAULT_VFPGA_ID, getpid()));
+    }
+
+    std::vector<std::pair<coyote::localSg, coyote::localSg>> sg_list;
+    for (unsigned int i = 0; i < n_threads; i++) {
+        void *src_mem = coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, size});
+        void *dst_mem = coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, size});
+        if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+        if (i != 0) {
+            coyote_threads[0]->userMap(src_mem, size);
+            coyote_threads[0]->userMap(dst_mem, size);
+        }
+
+        coyote::localSg src_sg = { .addr = src_mem, .len = size };
+        coyote::localSg dst_sg = { .addr = dst_mem, .len = size };
+        sg_list.emplace_back(std::make_pair(src_sg, dst_sg));
+    }
+
+    HEADER("PERF HOST: MULTI-PRODUCER SUBMISSION");
+    run_bench(coyote_threads, sg_list, n_rounds, n_inflight, ShareMode::PRIVATE);
+    run_bench(coyote_threads, sg_list, n_rounds, n_inflight, ShareMode::MUTEX);
+    run_bench(coyote_threads, sg_list, n_rounds, n_inflight, ShareMode::MPSC);
+
+    for (unsigned int i = 1; i < n_threads; i++) {
+        coyote_threads[0]->userUnmap(sg_list[i].first.addr);
+        coyote_threads[0]->userUnmap(sg_list[i].second.addr);
+    }
+
+    return EXIT_SUCCESS;
+}
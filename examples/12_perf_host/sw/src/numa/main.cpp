@@ -0,0 +1,110 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Returns the average throughput (in MB/s) of transfers between two buffers, allocated on the given NUMA node
+double run_bench(coyote::cThread &coyote_thread, int32_t numa_node, unsigned int n_runs, uint32_t size) {
+    void *src_mem = coyote_thread.getMem({.alloc = coyote::CoyoteAllocType::HPF, .size = size, .numa_node = numa_node});
+    void *dst_mem = coyote_thread.getMem({.alloc = coyote::CoyoteAllocType::HPF, .size = size, .numa_node = numa_node});
+    if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+
+    coyote::localSg src_sg = { .addr = src_mem, .len = size };
+    coyote::localSg dst_sg = { .addr = dst_mem, .len = size };
+
+    auto prep_fn = [&]() {
+        coyote_thread.clearCompleted();
+    };
+
+    auto bench_fn = [&]() {
+        coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != 1) {}
+    };
+
+    coyote::cBench bench(n_runs, 5);
+    bench.execute(bench_fn, prep_fn);
+
+    coyote_thread.freeMem(src_mem);
+    coyote_thread.freeMem(dst_mem);
+    return (double) size / (1024.0 * 1024.0 * 1e-9 * bench.getAvg());
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs, size_mb;
+    int32_t remote_node;
+
+    boost::program_options::options_description runtime_options("Coyote NUMA Placement Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(50), "Number of times to repeat the test")
+        ("size,s", boost::program_options::value<unsigned int>(&size_mb)->default_value(64), "Size of the transfers, in MB")
+        ("remote,n", boost::program_options::value<int32_t>(&remote_node)->default_value(-1), "Remote NUMA node; by default, node 1 (or 0, if the device is on node 1)");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    if (size_mb > 128) {
+        throw std::runtime_error("Transfer size must be at most 128 MB; exiting...");
+    }
+
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    int32_t device_node = coyote_thread.getNumaNode();
+    if (device_node < 0) {
+        std::cout << "The NUMA node of the device is unknown (e.g., a single-socket system); exiting..." << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (remote_node < 0) {
+        remote_node = device_node == 1 ? 0 : 1;
+    }
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Transfer size [MB]: " << size_mb << std::endl;
+    std::cout << "Device NUMA node: " << device_node << std::endl;
+    std::cout << "Remote NUMA node: " << remote_node << std::endl << std::endl;
+
+    // The CPU issuing the commands should also be on the device's node, so that only the placement of the memory differs
+    coyote_thread.pinToDevice();
+
+    HEADER("PERF HOST: NUMA PLACEMENT");
+    uint32_t size = size_mb * 1024 * 1024;
+    double local_throughput = run_bench(coyote_thread, device_node, n_runs, size);
+    double remote_throughput = run_bench(coyote_thread, remote_node, n_runs, size);
+    std::cout << "Local placement (node " << device_node << "):  " << std::setw(8) << local_throughput << " MB/s" << std::endl;
+    std::cout << "Remote placement (node " << remote_node << "): " << std::setw(8) << remote_throughput << " MB/s" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Maximum number of outstanding transfers when measuring the capacity of the vFPGA (closed loop)
+#define N_IN_FLIGHT 32
+
+// Offered loads of the sweep, as fractions of the measured capacity; the last points overload the vFPGA
+static const std::vector<double> LOAD_FRACTIONS = { 0.1, 0.25, 0.5, 0.6, 0.7, 0.8, 0.9, 0.95, 1.0, 1.1 };
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    bool poisson;
+    unsigned int n_runs, size;
+
+    boost::program_options::options_description runtime_options("Coyote Open-Loop Load Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(100000), "Number of requests per offered load")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(4096), "Transfer size of every request")
+        ("poisson,p", boost::program_options::value<bool>(&poisson)->default_value(true), "Arrivals: POISSON(1) or CONSTANT(0)");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Requests per offered load: " << n_runs << std::endl;
+    std::cout << "Transfer size: " << size << std::endl;
+    std::cout << "Arrivals: " << (poisson ? "POISSON" : "CONSTANT") << std::endl << std::endl;
+
+    // Create Coyote thread and allocate source & destination memory
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    void *src_mem = coyote_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+    void *dst_mem = coyote_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+    if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+    coyote::localSg src_sg = { .addr = src_mem, .len = size };
+    coyote::localSg dst_sg = { .addr = dst_mem, .len = size };
+
+    // Every request is a single transfer; transfers complete in order, so the completion counter is the number of completed requests
+    auto issue_fn = [&](unsigned int) {
+        coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+    };
+
+    auto wait_fn = [&](unsigned int i) {
+        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) < i + 1) {}
+    };
+
+    auto poll_fn = [&]() {
+        return coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER);
+    };
+
+    auto prep_fn = [&]() {
+        coyote_thread.clearCompleted();
+    };
+
+    // Capacity of the vFPGA for this transfer size, measured in a closed loop with many transfers in flight
+    coyote::cBench capacity_bench(100, 10);
+    capacity_bench.executeThroughput(1024, N_IN_FLIGHT, issue_fn, wait_fn, prep_fn);
+    double capacity = capacity_bench.getOpsPerSec().avg;
+
+    HEADER("PERF HOST: OPEN-LOOP LOAD");
+    std::cout << "Closed-loop capacity: " << capacity << " requests/s" << std::endl;
+
+    // Latency-vs-throughput curve; latencies are measured from the intended issue time, so they include the queueing delay
+    std::vector<double> rates;
+    for (double fraction : LOAD_FRACTIONS) {
+        rates.push_back(fraction * capacity);
+    }
+
+    coyote::cBench bench(n_runs, n_runs / 10);
+    std::vector<coyote::cLoadPoint> curve = bench.executeLoadSweep(
+        rates, poisson ? coyote::cArrivals::POISSON : coyote::cArrivals::CONSTANT, issue_fn, poll_fn, prep_fn
+    );
+    for (const coyote::cLoadPoint &point : curve) {
+        std::cout << "Offered: " << std::setw(10) << point.offered_rate << " req/s; ";
+        std::cout << "Achieved: " << std::setw(10) << point.achieved_rate << " req/s; ";
+        std::cout << "P50: " << std::setw(8) << point.p50_latency / 1e3 << " us; ";
+        std::cout << "P99: " << std::setw(8) << point.p99_latency / 1e3 << " us; ";
+        std::cout << "P99.9: " << std::setw(8) << point.p999_latency / 1e3 << " us" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cThreadPool.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Every skew-th transfer is large, the others are small; with a static assignment of transfers
+// to streams (transfer i on stream i % n_streams), the large transfers all end up on the same stream
+uint32_t get_size(unsigned int i, unsigned int skew, uint32_t small_size, uint32_t large_size) {
+    return i % skew == 0 ? large_size : small_size;
+}
+
+// Static assignment: the i-th application thread executes every n_streams-th transfer on the i-th cThread and stream
+double run_static(
+    coyote::cThreadPool &pool, std::vector<std::pair<char*, char*>> &mems, unsigned int n_transfers, 
+    unsigned int skew, uint32_t small_size, uint32_t large_size
+) {
+    auto begin_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned int s = 0; s < pool.getNumWorkers(); s++) {
+        workers.emplace_back([&, s]() {
+            coyote::cThread *coyote_thread = pool.getThread(s);
+            for (unsigned int i = s; i < n_transfers; i += pool.getNumWorkers()) {
+                uint32_t size = get_size(i, skew, small_size, large_size);
+                coyote::localSg src_sg = { .addr = mems[s].first, .len = size, .dest = s };
+                coyote::localSg dst_sg = { .addr = mems[s].second, .len = size, .dest = s };
+                coyote::cmplToken token = coyote_thread->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+                while (!coyote_thread->isCompleted(token)) {}
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count();
+}
+
+// Pool: all the transfers are queued to the pool, which runs them on any idle stream
+double run_pool(
+    coyote::cThreadPool &pool, std::vector<std::pair<char*, char*>> &mems, unsigned int n_transfers, 
+    unsigned int skew, uint32_t small_size, uint32_t large_size
+) {
+    auto begin_time = std::chrono::high_resolution_clock::now();
+
+    for (unsigned int i = 0; i < n_transfers; i++) {
+        uint32_t size = get_size(i, skew, small_size, large_size);
+        auto &mem = mems[i % mems.size()];
+        coyote::localSg src_sg = { .addr = mem.first, .len = size, .dest = coyote::DEST_ANY };
+        coyote::localSg dst_sg = { .addr = mem.second, .len = size, .dest = coyote::DEST_ANY };
+        pool.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+    }
+    pool.drain();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count();
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_streams, n_transfers, skew;
+    uint32_t small_size, large_size;
+
+    boost::program_options::options_description runtime_options("Coyote Thread Pool Options");
+    runtime_options.add_options()
+        ("streams,t", boost::program_options::value<unsigned int>(&n_streams)->default_value(4), "Number of host streams (and cThreads)")
+        ("transfers,n", boost::program_options::value<unsigned int>(&n_transfers)->default_value(4096), "Number of transfers")
+        ("skew,k", boost::program_options::value<unsigned int>(&skew)->default_value(8), "Every k-th transfer is large")
+        ("small,s", boost::program_options::value<uint32_t>(&small_size)->default_value(4 * 1024), "Size of the small transfers")
+        ("large,l", boost::program_options::value<uint32_t>(&large_size)->default_value(1024 * 1024), "Size of the large transfers");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of host streams: " << n_streams << std::endl;
+    std::cout << "Number of transfers: " << n_transfers << std::endl;
+    std::cout << "Every k-th transfer is large: " << skew << std::endl;
+    std::cout << "Small transfer size: " << small_size << std::endl;
+    std::cout << "Large transfer size: " << large_size << std::endl << std::endl;
+
+    coyote::cThreadPool pool(DEFAULT_VFPGA_ID, n_streams);
+
+    // One pair of buffers per stream, mapped into all the cThreads of the pool
+    std::vector<std::pair<char*, char*>> mems;
+    for (unsigned int s = 0; s < n_streams; s++) {
+        char *src_mem = (char *) pool.getMem({coyote::CoyoteAllocType::HPF, large_size});
+        char *dst_mem = (char *) pool.getMem({coyote::CoyoteAllocType::HPF, large_size});
+        if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+        mems.emplace_back(src_mem, dst_mem);
+    }
+
+    double n_bytes = 0;
+    for (unsigned int i = 0; i < n_transfers; i++) {
+        n_bytes += get_size(i, skew, small_size, large_size);
+    }
+
+    HEADER("PERF HOST: THREAD POOL");
+    double static_time = run_static(pool, mems, n_transfers, skew, small_size, large_size);
+    std::cout << "Static assignment: " << std::setw(8) << n_bytes / static_time << " GB/s" << std::endl;
+
+    double pool_time = run_pool(pool, mems, n_transfers, skew, small_size, large_size);
+    coyote::cThreadPoolStats stats = pool.getStats();
+    std::cout << "Thread pool:       " << std::setw(8) << n_bytes / pool_time << " GB/s; stolen transfers: " << stats.n_stolen << " / " << stats.n_executed << std::endl;
+
+    for (auto &mem : mems) {
+        pool.freeMem(mem.first);
+        pool.freeMem(mem.second);
+    }
+
+    return EXIT_SUCCESS;
+}
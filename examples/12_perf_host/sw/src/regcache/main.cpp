@@ -0,0 +1,115 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs, n_bufs, size;
+
+    boost::program_options::options_description runtime_options("Coyote Registration Cache Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(10), "Number of times to repeat the test")
+        ("bufs,n", boost::program_options::value<unsigned int>(&n_bufs)->default_value(64), "Number of user buffers, which are transferred round-robin")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(65536), "Size of every buffer, in bytes");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Number of buffers: " << n_bufs << std::endl;
+    std::cout << "Buffer size [B]: " << size << std::endl << std::endl;
+
+    // The buffers are allocated by the application (e.g., owned by another library), rather than with getMem
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    std::vector<void *> src_bufs(n_bufs), dst_bufs(n_bufs);
+    for (unsigned int i = 0; i < n_bufs; i++) {
+        src_bufs[i] = aligned_alloc(coyote::PAGE_SIZE, size);
+        dst_bufs[i] = aligned_alloc(coyote::PAGE_SIZE, size);
+        if (!src_bufs[i] || !dst_bufs[i]) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+    }
+
+    auto prep_fn = [&]() {
+        coyote_thread.clearCompleted();
+    };
+
+    // Transfers every buffer once; each buffer is explicitly registered before the transfer and unregistered afterwards
+    auto map_fn = [&]() {
+        for (unsigned int i = 0; i < n_bufs; i++) {
+            coyote_thread.userMap(src_bufs[i], size);
+            coyote_thread.userMap(dst_bufs[i], size);
+            coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, {.addr = src_bufs[i], .len = size}, {.addr = dst_bufs[i], .len = size});
+            while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != i + 1) {}
+            coyote_thread.userUnmap(src_bufs[i]);
+            coyote_thread.userUnmap(dst_bufs[i]);
+        }
+    };
+
+    // Transfers every buffer once; the buffers are registered by invoke on first use and cached afterwards
+    auto cache_fn = [&]() {
+        for (unsigned int i = 0; i < n_bufs; i++) {
+            coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, {.addr = src_bufs[i], .len = size}, {.addr = dst_bufs[i], .len = size});
+            while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != i + 1) {}
+        }
+    };
+
+    HEADER("PERF HOST: REGISTRATION CACHE");
+    coyote::cBench bench_map(n_runs, 1);
+    bench_map.execute(map_fn, prep_fn);
+    std::cout << "userMap/userUnmap per transfer: " << std::setw(10) << (double) n_bufs / (1e-9 * bench_map.getAvg()) << " transfers/s" << std::endl;
+
+    coyote_thread.setRegCache(true);
+    coyote::cBench bench_cache(n_runs, 1);
+    bench_cache.execute(cache_fn, prep_fn);
+    std::cout << "Registration cache:             " << std::setw(10) << (double) n_bufs / (1e-9 * bench_cache.getAvg()) << " transfers/s" << std::endl;
+
+    coyote::cRegCacheStats stats = coyote_thread.getRegCacheStats();
+    std::cout << std::endl << "Cache: " << stats.n_hits << " hits, " << stats.n_misses << " misses, " << stats.n_evictions << " evictions, ";
+    std::cout << stats.pinned_bytes / 1024 << " KB pinned" << std::endl;
+
+    // Release the cached registrations, before the memory is returned to the system
+    for (unsigned int i = 0; i < n_bufs; i++) {
+        coyote_thread.invalidateRegCache(src_bufs[i], size);
+        coyote_thread.invalidateRegCache(dst_bufs[i], size);
+        free(src_bufs[i]);
+        free(dst_bufs[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Number of transfers issued by every thread in every test run
+#define N_TRANSFERS 16
+
+// Every software thread has its own cThread (and hence ctid) on the same vFPGA; all the threads start every run at the 
+// same time, so the measured times include the contention between the ctids for the command FIFO and the DMA engines
+void run_bench(
+    std::vector<std::unique_ptr<coyote::cThread>> &coyote_threads, std::vector<std::pair<void*, void*>> &mems,
+    unsigned int n_threads, unsigned int size, unsigned int n_runs, const std::vector<uint32_t> &cpus
+) {
+    auto prep_fn = [&](unsigned int tid) {
+        coyote_threads[tid]->clearCompleted();
+    };
+
+    auto bench_fn = [&](unsigned int tid) {
+        coyote::localSg src_sg = { .addr = mems[tid].first, .len = size };
+        coyote::localSg dst_sg = { .addr = mems[tid].second, .len = size };
+        for (unsigned int i = 0; i < N_TRANSFERS; i++) {
+            coyote_threads[tid]->invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+        }
+        while (coyote_threads[tid]->checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != N_TRANSFERS) {}
+    };
+
+    coyote::cBench bench(n_runs, 10);
+    bench.setWork((uint64_t) N_TRANSFERS * size, N_TRANSFERS);
+    bench.executeThreads(n_threads, bench_fn, prep_fn, cpus);
+
+    // Fairness between the threads: the range of the per-thread throughput
+    double min_thr = 0, max_thr = 0;
+    for (unsigned int i = 0; i < n_threads; i++) {
+        double thr = bench.getThreadBytesPerSec(i).avg;
+        min_thr = i == 0 ? thr : std::min(min_thr, thr);
+        max_thr = i == 0 ? thr : std::max(max_thr, thr);
+    }
+
+    coyote::cBenchInterval throughput = bench.getGBPerSec();
+    std::cout << "Threads: " << std::setw(3) << n_threads << "; ";
+    std::cout << "Aggregate: " << std::setw(8) << throughput.avg << " GB/s (" << throughput.lo << " - " << throughput.hi << "); ";
+    std::cout << "Per thread: " << min_thr / 1e9 << " - " << max_thr / 1e9 << " GB/s; ";
+    std::cout << "Run time P50: " << std::setw(8) << bench.getP50() / 1e3 << " us, P99: " << std::setw(8) << bench.getP99() / 1e3 << " us" << std::endl;
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    bool pin;
+    unsigned int n_runs, size, max_threads;
+
+    boost::program_options::options_description runtime_options("Coyote Thread Scaling Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(1000), "Number of times to repeat the test")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(4096), "Transfer size")
+        ("threads,t", boost::program_options::value<unsigned int>(&max_threads)->default_value(16), "Ending (maximum) number of threads")
+        ("pin,p", boost::program_options::value<bool>(&pin)->default_value(true), "Pin every thread to its own CPU");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Transfer size: " << size << std::endl;
+    std::cout << "Transfers per thread and run: " << N_TRANSFERS << std::endl;
+    std::cout << "Ending number of threads: " << max_threads << std::endl;
+    std::cout << "Pin threads: " << pin << std::endl << std::endl;
+
+    // Create one Coyote thread per software thread, each with its own source & destination buffers
+    std::vector<std::unique_ptr<coyote::cThread>> coyote_threads;
+    std::vector<std::pair<void*, void*>> mems;
+    for (unsigned int i = 0; i < max_threads; i++) {
+        coyote_threads.emplace_back(new coyote::cThread(DEFAULT_VFPGA_ID, getpid()));
+        void *src_mem = coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, size});
+        void *dst_mem = coyote_threads[i]->getMem({coyote::CoyoteAllocType::HPF, size});
+        if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+        mems.emplace_back(src_mem, dst_mem);
+    }
+
+    // Thread i is pinned to CPU i, so the threads don't compete for CPUs
+    std::vector<uint32_t> cpus;
+    if (pin) {
+        for (unsigned int i = 0; i < std::thread::hardware_concurrency(); i++) {
+            cpus.push_back(i);
+        }
+    }
+
+    // Benchmark sweep: aggregate throughput, fairness and latency for an increasing number of threads
+    HEADER("PERF HOST: THREAD SCALING");
+    for (unsigned int n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        run_bench(coyote_threads, mems, n_threads, size, n_runs, cpus);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <vector>
+#include <cstring>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs, n_records, record_size;
+
+    boost::program_options::options_description runtime_options("Coyote Scatter-Gather Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(100), "Number of times to repeat the test")
+        ("records,n", boost::program_options::value<unsigned int>(&n_records)->default_value(256), "Number of records per transfer")
+        ("size,s", boost::program_options::value<unsigned int>(&record_size)->default_value(1024), "Size of every record");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Records per transfer: " << n_records << std::endl;
+    std::cout << "Record size: " << record_size << std::endl << std::endl;
+
+    // The records are placed in a larger region, with a gap after every record, so they are not contiguous in memory
+    uint32_t total_size = n_records * record_size;
+    coyote::cThread coyote_thread(DEFAULT_VFPGA_ID, getpid());
+    char *records_mem = (char *) coyote_thread.getMem({coyote::CoyoteAllocType::REG, 2 * total_size});
+    char *staging_mem = (char *) coyote_thread.getMem({coyote::CoyoteAllocType::HPF, total_size});
+    char *dst_mem = (char *) coyote_thread.getMem({coyote::CoyoteAllocType::HPF, total_size});
+    if (!records_mem || !staging_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+
+    coyote::sgList src_list;
+    for (unsigned int i = 0; i < n_records; i++) {
+        memset(records_mem + 2 * i * record_size, i, record_size);
+        src_list.push_back({ .addr = records_mem + 2 * i * record_size, .len = record_size });
+    }
+    coyote::localSg staging_sg = { .addr = staging_mem, .len = total_size };
+    coyote::localSg dst_sg = { .addr = dst_mem, .len = total_size };
+
+    auto prep_fn = [&]() {
+        coyote_thread.clearCompleted();
+        memset(dst_mem, 0, total_size);
+    };
+
+    // Staging: copy all the records into one contiguous buffer and transfer it
+    auto staging_fn = [&]() {
+        for (unsigned int i = 0; i < n_records; i++) {
+            memcpy(staging_mem + i * record_size, src_list[i].addr, record_size);
+        }
+        coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, staging_sg, dst_sg);
+        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != 1) {}
+    };
+
+    // Zero-copy: stream the records directly from their buffers, as one logical packet
+    auto sg_fn = [&]() {
+        coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_list, coyote::sgList{ dst_sg });
+        while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != 1) {}
+    };
+
+    HEADER("PERF HOST: SCATTER-GATHER");
+    for (bool zero_copy : {false, true}) {
+        coyote::cBench bench(n_runs);
+        if (zero_copy) {
+            bench.execute(sg_fn, prep_fn);
+        } else {
+            bench.execute(staging_fn, prep_fn);
+        }
+
+        // Verify that the records arrived in order
+        for (unsigned int i = 0; i < n_records; i++) {
+            if (dst_mem[i * record_size] != (char) i) { throw std::runtime_error("Destination data mismatch; exiting..."); }
+        }
+
+        std::cout << (zero_copy ? "sgList (zero-copy): " : "memcpy + invoke:    ");
+        std::cout << "Avg. latency: " << std::setw(10) << bench.getAvg() / 1e3 << " us; ";
+        std::cout << "Throughput: " << std::setw(8) << (double) total_size / (1024.0 * 1024.0 * 1e-9 * bench.getAvg()) << " MB/s" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/**
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <iomanip>
+#include <iostream>
+
+// External library for easier parsing of CLI arguments by the executable
+#include <boost/program_options.hpp>
+
+// Coyote-specific includes
+#include "cBench.hpp"
+#include "cThread.hpp"
+
+// Constants
+#define DEFAULT_VFPGA_ID 0
+
+// Per-request lifecycle of a cThread in a service, from the first command until the cThread is ready for the next request
+enum class StartupMode {
+    COLD,       // A new cThread for every request, without any cached state (as for the first cThread of a process)
+    CACHED,     // A new cThread for every request, reusing the cached shell configuration and mappings
+    RESET       // One cThread for all the requests, reset after every request; the buffers stay mapped
+};
+
+// A request: a single transfer to/from the buffers of the cThread, which is awaited before the request finishes
+void run_request(coyote::cThread &coyote_thread, void *src_mem, void *dst_mem, unsigned int size) {
+    coyote::localSg src_sg = { .addr = src_mem, .len = size };
+    coyote::localSg dst_sg = { .addr = dst_mem, .len = size };
+    coyote_thread.invoke(coyote::CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg);
+    while (coyote_thread.checkCompleted(coyote::CoyoteOper::LOCAL_TRANSFER) != 1) {}
+}
+
+void run_bench(StartupMode mode, unsigned int size, unsigned int n_runs) {
+    // Only used in RESET mode; otherwise, the cThread and the buffers are created for every request
+    std::unique_ptr<coyote::cThread> coyote_thread;
+    void *src_mem = nullptr, *dst_mem = nullptr;
+    if (mode == StartupMode::RESET) {
+        coyote_thread = std::make_unique<coyote::cThread>(DEFAULT_VFPGA_ID, getpid());
+        src_mem = coyote_thread->getMem({coyote::CoyoteAllocType::HPF, size});
+        dst_mem = coyote_thread->getMem({coyote::CoyoteAllocType::HPF, size});
+        if (!src_mem || !dst_mem) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+    }
+
+    auto prep_fn = [&]() {
+        if (mode == StartupMode::COLD) {
+            coyote::cThread::releaseShellCache();
+        }
+    };
+
+    auto bench_fn = [&]() {
+        if (mode == StartupMode::RESET) {
+            run_request(*coyote_thread, src_mem, dst_mem, size);
+            coyote_thread->reset();
+        } else {
+            // The destructor unmaps the buffers and unregisters the ctid
+            coyote::cThread request_thread(DEFAULT_VFPGA_ID, getpid());
+            void *src = request_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+            void *dst = request_thread.getMem({coyote::CoyoteAllocType::HPF, size});
+            if (!src || !dst) { throw std::runtime_error("Could not allocate memory; exiting..."); }
+            run_request(request_thread, src, dst, size);
+        }
+    };
+
+    coyote::cBench bench(n_runs, 0);
+    bench.execute(bench_fn, prep_fn);
+
+    switch (mode) {
+        case StartupMode::COLD:   std::cout << "New cThread (cold):   "; break;
+        case StartupMode::CACHED: std::cout << "New cThread (cached): "; break;
+        case StartupMode::RESET:  std::cout << "Reused cThread:       "; break;
+    }
+    std::cout << "avg: " << std::setw(10) << bench.getAvg() / 1e3 << " us; ";
+    std::cout << "P50: " << std::setw(10) << bench.getP50() / 1e3 << " us; ";
+    std::cout << "P99: " << std::setw(10) << bench.getP99() / 1e3 << " us" << std::endl;
+}
+
+int main(int argc, char *argv[])  {
+    // CLI arguments
+    unsigned int n_runs, size;
+
+    boost::program_options::options_description runtime_options("Coyote cThread Startup Options");
+    runtime_options.add_options()
+        ("runs,r", boost::program_options::value<unsigned int>(&n_runs)->default_value(100), "Number of times to repeat the test")
+        ("size,s", boost::program_options::value<unsigned int>(&size)->default_value(4096), "Transfer size of every request");
+    boost::program_options::variables_map command_line_arguments;
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, runtime_options), command_line_arguments);
+    boost::program_options::notify(command_line_arguments);
+
+    HEADER("CLI PARAMETERS:");
+    std::cout << "Number of test runs: " << n_runs << std::endl;
+    std::cout << "Transfer size: " << size << std::endl << std::endl;
+
+    // Per-request latency, including the creation (or reset) of the cThread and a single transfer
+    HEADER("PERF HOST: CTHREAD STARTUP");
+    run_bench(StartupMode::COLD, size, n_runs);
+    run_bench(StartupMode::CACHED, size, n_runs);
+    run_bench(StartupMode::RESET, size, n_runs);
+
+    return EXIT_SUCCESS;
+}
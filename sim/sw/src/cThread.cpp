@@ -49,8 +49,7 @@ thread out_thread;
 thread sim_thread;
 
 cThread::cThread(int32_t vfid, pid_t hpid, uint32_t device, void (*uisr)(int)):
-  hpid(hpid), vfid(vfid),
-  vlock(boost::interprocess::open_or_create, ("vpga_mtx_user_" + std::to_string(std::time(nullptr))).c_str()) { // Timestamp for plock to prevent multiple users aquiring the same lock at the same time which does not matter for the simulation, only for hardware
+  device(device), vfid(vfid), hpid(hpid), uisr(uisr) {
     std::filesystem::path sim_path(SIM_DIR);
     sim_path /= "sim";
     string input_file_name((sim_path / "input.bin").string());
@@ -113,6 +112,7 @@ cThread::~cThread() {
 		freeMem((*mapped_pages.begin()).first);
 	}
 	mapped_pages.clear();
+    reg_cache.clear();
 
     input_writer.close();
 
@@ -120,10 +120,56 @@ cThread::~cThread() {
     out_thread.join();
 }
 
+void cThread::reset() {
+    post_oper = CoyoteOper::NOOP;
+    clearCompleted();
+    DEBUG("reset() finished")
+}
+
+void cThread::releaseShellCache() {
+    // Do nothing, since the simulation doesn't map any registers
+}
+
 void cThread::postCmd(uint64_t offs_3, uint64_t offs_2, uint64_t offs_1, uint64_t offs_0) {
     // Do nothing because protected function
 }
 
+void cThread::postCmds(const cmdDesc *cmds, uint32_t n_cmds) {
+    // Do nothing because protected function
+}
+
+uint32_t cThread::acquireCmdCredits(uint32_t n_cmds) {
+    // Do nothing because protected function
+    return n_cmds;
+}
+
+cmdDesc cThread::rdmaCmd(CoyoteOper oper, const rdmaSg &sg, bool last) const {
+    // Do nothing because protected function
+    return { 0 };
+}
+
+uint32_t cThread::getNumChunks(uint64_t len) const {
+    return len == 0 ? 1 : static_cast<uint32_t>((len + chunk_size - 1) / chunk_size);
+}
+
+void cThread::postLocalCmds(const localSg *src_sgs, size_t n_src, const localSg *dst_sgs, size_t n_dst, bool last) {
+    // Do nothing because protected function
+}
+
+uint32_t cThread::readCmdCnt() const {
+    // Do nothing because protected function
+    return 0;
+}
+
+void cThread::writeCmd(const cmdDesc &cmd) {
+    // Do nothing because protected function
+}
+
+uint64_t cThread::localCtrlCmd(const localSg &sg, bool last) const {
+    // Do nothing because protected function
+    return 0;
+}
+
 void cThread::mmapFpga() {
     // Do nothing because protected function
 }
@@ -132,15 +178,33 @@ void cThread::munmapFpga() {
     // Do nothing because protected function
 }
 
+void cThread::startEventThread() {
+    // Do nothing because protected function
+}
+
 void cThread::userMap(void *vaddr, uint32_t len) {
+    // Release any cached registrations of the same pages first, so that they don't unmap the buffer once evicted
+    reg_cache.invalidate(vaddr, len);
+    mapUserMem(vaddr, len);
+    reg_cache.insertUser(vaddr, len);
+}
+
+void cThread::userUnmap(void *vaddr) {
+    reg_cache.removeUser(vaddr);
+    unmapUserMem(vaddr);
+}
+
+void cThread::mapUserMem(void *vaddr, uint32_t len) {
     executeUnlessCrash([&] { 
         input_writer.userMap(reinterpret_cast<uint64_t>(vaddr), len);
+        statAdd(counters.n_map_ioctls);
     });
 }
 
-void cThread::userUnmap(void *vaddr) {
+void cThread::unmapUserMem(void *vaddr) {
     executeUnlessCrash([&] { 
         input_writer.userUnmap(reinterpret_cast<uint64_t>(vaddr));
+        statAdd(counters.n_unmap_ioctls);
     });
 }
 
@@ -220,6 +284,7 @@ void cThread::freeMem(void* vaddr) {
 void cThread::setCSR(uint64_t val, uint32_t offs) {
     executeUnlessCrash([&] { 
         input_writer.setCSR(offs, val);
+        statAdd(counters.n_csr_writes);
     });
     DEBUG("setCSR(" << val << ", " << offs << ") finished")
 }
@@ -229,12 +294,29 @@ uint64_t cThread::getCSR(uint32_t offs) const {
     executeUnlessCrash([&] { 
         input_writer.getCSR(offs);
         result = output_reader.getCSRResult();
+        statAdd(counters.n_csr_reads);
     });
     DEBUG("getCSR(" << offs << ") finished")
     return result;
 }
 
-void cThread::invoke(CoyoteOper oper, syncSg sg) {
+void cThread::setCSRs(uint32_t offs, const uint64_t *vals, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        setCSR(vals[i], offs + i);
+    }
+}
+
+void cThread::setCSRs(uint32_t offs, const std::vector<uint64_t> &vals) {
+    setCSRs(offs, vals.data(), vals.size());
+}
+
+void cThread::getCSRs(uint32_t offs, uint64_t *vals, uint32_t n) const {
+    for (uint32_t i = 0; i < n; i++) {
+        vals[i] = getCSR(offs + i);
+    }
+}
+
+cmplToken cThread::invoke(CoyoteOper oper, syncSg sg) {
     DEBUG("cThread: Call invoke for a sync/offload operation with address " << sg.addr << ", length " << sg.len)
     
     // Argument checks
@@ -242,46 +324,60 @@ void cThread::invoke(CoyoteOper oper, syncSg sg) {
         throw std::runtime_error("ERROR: cThread::invoke() called with syncSg flags, but the operation is not a LOCAL_SYNC or LOCAL_OFFLOAD; exiting...");
     }
 
-    if (sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
-    }
+    // Register the buffer, if it's not mapped yet and the registration cache is enabled
+    reg_cache.acquire(sg.addr, sg.len);
+
+    // Trigger the operation and wait for its completion
+    auto post_req = [&](const syncSg &req) {
+        auto prevCompleted = checkCompleted(oper);
+
+        if (oper == CoyoteOper::LOCAL_OFFLOAD) {
+            executeUnlessCrash([&] {
+                input_writer.writeMem(
+                    reinterpret_cast<uint64_t>(req.addr), 
+                    req.len,
+                    req.addr
+                );
+                input_writer.invoke(
+                    (uint8_t) CoyoteOper::LOCAL_OFFLOAD, 0, 0, 
+                    reinterpret_cast<uint64_t>(req.addr), 
+                    req.len, 0
+                );
+            });
+        } else if (oper == CoyoteOper::LOCAL_SYNC) {
+            executeUnlessCrash([&] {
+                input_writer.invoke(
+                    (uint8_t) CoyoteOper::LOCAL_SYNC, 0, 0, 
+                    reinterpret_cast<uint64_t>(req.addr), 
+                    req.len, 0
+                );
+            });
+        }
+        statAdd(counters.n_cmds[static_cast<uint32_t>(oper)]);
+        statAdd(counters.n_bytes[static_cast<uint32_t>(oper)], req.len);
 
-    auto prevCompleted = checkCompleted(oper);
-
-    // Trigger the operation
-    if (oper == CoyoteOper::LOCAL_OFFLOAD) {
-        executeUnlessCrash([&] {
-            input_writer.writeMem(
-                reinterpret_cast<uint64_t>(sg.addr), 
-                sg.len,
-                sg.addr
-            );
-            input_writer.invoke(
-                (uint8_t) CoyoteOper::LOCAL_OFFLOAD, 0, 0, 
-                reinterpret_cast<uint64_t>(sg.addr), 
-                sg.len, 0
-            );
-        });
-    } else if (oper == CoyoteOper::LOCAL_SYNC) {
-        executeUnlessCrash([&] {
-            input_writer.invoke(
-                (uint8_t) CoyoteOper::LOCAL_SYNC, 0, 0, 
-                reinterpret_cast<uint64_t>(sg.addr), 
-                sg.len, 0
-            );
+        executeUnlessCrash([&] { 
+            input_writer.checkCompleted((uint8_t) oper, prevCompleted + 1, true);
+            DEBUG("Blocking checkCompleted for sync or offload")
+            output_reader.checkCompletedResult();
         });
+    };
+
+    // Split long transfers into chunks, which are issued one after the other
+    statAdd(counters.n_ops[static_cast<uint32_t>(oper)]);
+    if (sg.len > chunk_size) {
+        for (uint64_t offs = 0; offs < sg.len; offs += chunk_size) {
+            post_req({ .addr = reinterpret_cast<char *>(sg.addr) + offs, .len = std::min(sg.len - offs, static_cast<uint64_t>(chunk_size)) });
+        }
+    } else {
+        post_req(sg);
     }
 
-    executeUnlessCrash([&] { 
-        input_writer.checkCompleted((uint8_t) oper, prevCompleted + 1, true);
-        DEBUG("Blocking checkCompleted for sync or offload")
-        output_reader.checkCompletedResult();
-    });
-
     DEBUG("invoke(...) finished")
+    return CMPL_TOKEN_NONE;
 }
 
-void cThread::invoke(CoyoteOper oper, localSg sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, localSg sg, bool last) {
     // Argument checks
     DEBUG("cThread: Call invoke for a one-side local operation with address " << sg.addr << ", length " << sg.len)
 
@@ -289,44 +385,36 @@ void cThread::invoke(CoyoteOper oper, localSg sg, bool last) {
         throw std::runtime_error("ERROR: cThread::invoke() called with localSg flags, but the operation is not a LOCAL_READ or LOCAL_WRITE; exiting...");
     }
 
-    if (sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
-    }
-
-    // Trigger the operation
-    if (isLocalRead(oper)) {
-        executeUnlessCrash([&] {
-            input_writer.writeMem(
-                reinterpret_cast<uint64_t>(sg.addr), 
-                sg.len,
-                sg.addr
-            );
-            input_writer.invoke(
-                (uint8_t) CoyoteOper::LOCAL_READ, 
-                sg.stream, 
-                sg.dest, 
-                reinterpret_cast<uint64_t>(sg.addr), 
-                sg.len,
-                last
-            );
-        });
-    } else if (isLocalWrite(oper)) {
-        executeUnlessCrash([&] { 
-            input_writer.invoke(
-                (uint8_t) CoyoteOper::LOCAL_WRITE, 
-                sg.stream, 
-                sg.dest, 
-                reinterpret_cast<uint64_t>(sg.addr), 
-                sg.len,
-                last
-            );
-        });
+    // Register the buffer, if it's not mapped yet and the registration cache is enabled
+    reg_cache.acquire(&sg, 1);
+
+    // Trigger the operation; as in hardware, transfers longer than the chunk size are split into multiple commands
+    cmplToken token = cmpl_queue.issue(oper, last);
+    statAdd(counters.n_ops[static_cast<uint32_t>(oper)]);
+    statAdd(counters.n_cmds[static_cast<uint32_t>(oper)], getNumChunks(sg.len));
+    statAdd(counters.n_bytes[static_cast<uint32_t>(oper)], sg.len);
+    for (uint32_t i = 0; i < getNumChunks(sg.len); i++) {
+        uint64_t addr = reinterpret_cast<uint64_t>(sg.addr) + static_cast<uint64_t>(i) * chunk_size;
+        uint32_t len = static_cast<uint32_t>(std::min(sg.len - static_cast<uint64_t>(i) * chunk_size, static_cast<uint64_t>(chunk_size)));
+        bool is_last = last && (i == getNumChunks(sg.len) - 1);
+
+        if (isLocalRead(oper)) {
+            executeUnlessCrash([&] {
+                input_writer.writeMem(addr, len, reinterpret_cast<void *>(addr));
+                input_writer.invoke((uint8_t) CoyoteOper::LOCAL_READ, sg.stream, sg.dest, addr, len, is_last);
+            });
+        } else if (isLocalWrite(oper)) {
+            executeUnlessCrash([&] { 
+                input_writer.invoke((uint8_t) CoyoteOper::LOCAL_WRITE, sg.stream, sg.dest, addr, len, is_last);
+            });
+        }
     }
 
     DEBUG("invoke(...) finished")
+    return token;
 }
 
-void cThread::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last) {
     // Argument checks
     DEBUG(
         "cThread: Call invoke for a two-sided local operation with source address " 
@@ -338,43 +426,174 @@ void cThread::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last)
         throw std::runtime_error("ERROR: cThread::invoke() called with two localSg flags, but the operation is not a LOCAL_TRANSFER; exiting...");
     }
 
-    if (src_sg.len > MAX_TRANSFER_SIZE || dst_sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    reg_cache.acquire(&src_sg, 1);
+    reg_cache.acquire(&dst_sg, 1);
+
+    // Trigger the operation; the chunks of the source and destination are interleaved, as in hardware
+    cmplToken token = cmpl_queue.issue(oper, last);
+    uint32_t n_src = getNumChunks(src_sg.len);
+    uint32_t n_dst = getNumChunks(dst_sg.len);
+    statAdd(counters.n_ops[static_cast<uint32_t>(oper)]);
+    statAdd(counters.n_cmds[static_cast<uint32_t>(oper)], std::max(n_src, n_dst));
+    statAdd(counters.n_bytes[static_cast<uint32_t>(oper)], src_sg.len);
+    for (uint32_t i = 0; i < std::max(n_src, n_dst); i++) {
+        if (i < n_src) {
+            uint64_t addr = reinterpret_cast<uint64_t>(src_sg.addr) + static_cast<uint64_t>(i) * chunk_size;
+            uint32_t len = static_cast<uint32_t>(std::min(src_sg.len - static_cast<uint64_t>(i) * chunk_size, static_cast<uint64_t>(chunk_size)));
+            executeUnlessCrash([&] {
+                input_writer.writeMem(addr, len, reinterpret_cast<void *>(addr));
+                input_writer.invoke((uint8_t) CoyoteOper::LOCAL_READ, src_sg.stream, src_sg.dest, addr, len, last && (i == n_src - 1));
+            });
+        }
+        if (i < n_dst) {
+            uint64_t addr = reinterpret_cast<uint64_t>(dst_sg.addr) + static_cast<uint64_t>(i) * chunk_size;
+            uint32_t len = static_cast<uint32_t>(std::min(dst_sg.len - static_cast<uint64_t>(i) * chunk_size, static_cast<uint64_t>(chunk_size)));
+            executeUnlessCrash([&] { 
+                input_writer.invoke((uint8_t) CoyoteOper::LOCAL_WRITE, dst_sg.stream, dst_sg.dest, addr, len, last && (i == n_dst - 1));
+            });
+        }
     }
 
-    // Trigger the operation
-    executeUnlessCrash([&] {
-        input_writer.writeMem(
-            reinterpret_cast<uint64_t>(src_sg.addr), 
-            src_sg.len,
-            src_sg.addr
-        );
-        input_writer.invoke(
-            (uint8_t) CoyoteOper::LOCAL_READ, 
-            src_sg.stream, 
-            src_sg.dest, 
-            reinterpret_cast<uint64_t>(src_sg.addr), 
-            src_sg.len,
-            last
-        );
-    });
-    executeUnlessCrash([&] { 
-        input_writer.invoke(
-            (uint8_t) CoyoteOper::LOCAL_WRITE, 
-            dst_sg.stream, 
-            dst_sg.dest, 
-            reinterpret_cast<uint64_t>(dst_sg.addr), 
-            dst_sg.len,
-            last
-        );
-    });
+    return token;
+}
+
+cmplToken cThread::invoke(CoyoteOper oper, const sgList &sg_list, bool last) {
+    DEBUG("cThread: Call invoke for a one-sided local operation with a scatter-gather list of " << sg_list.size() << " entries")
+
+    if (oper != CoyoteOper::LOCAL_READ && oper != CoyoteOper::LOCAL_WRITE) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with a single sgList, but the operation is not a LOCAL_READ or LOCAL_WRITE; exiting...");
+    }
+
+    if (sg_list.empty()) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with an empty sgList, exiting...");
+    }
+
+    // Only the final entry is flagged as last; the token is only assigned (and returned) for that one
+    cmplToken token = CMPL_TOKEN_NONE;
+    for (size_t i = 0; i < sg_list.size(); i++) {
+        token = invoke(oper, sg_list[i], last && (i == sg_list.size() - 1));
+    }
+
+    DEBUG("invoke(...) finished")
+    return token;
+}
+
+cmplToken cThread::invoke(CoyoteOper oper, const sgList &src_list, const sgList &dst_list, bool last) {
+    DEBUG(
+        "cThread: Call invoke for a two-sided local operation with scatter-gather lists of " 
+        << src_list.size() << " source entries and " << dst_list.size() << " destination entries"
+    )
+
+    if (oper != CoyoteOper::LOCAL_TRANSFER) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with two sgLists, but the operation is not a LOCAL_TRANSFER; exiting...");
+    }
+
+    if (src_list.empty() || dst_list.empty()) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with an empty sgList, exiting...");
+    }
+
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    reg_cache.acquire(src_list.data(), src_list.size());
+    reg_cache.acquire(dst_list.data(), dst_list.size());
+
+    // Entries are passed to the simulation one by one, interleaving the source and destination, as in hardware
+    cmplToken token = cmpl_queue.issue(oper, last);
+    uint32_t n_src = 0, n_dst = 0;
+    uint64_t n_bytes = 0;
+    for (const localSg &sg : src_list) {
+        n_src += getNumChunks(sg.len);
+        n_bytes += sg.len;
+    }
+    for (const localSg &sg : dst_list) {
+        n_dst += getNumChunks(sg.len);
+    }
+    statAdd(counters.n_ops[static_cast<uint32_t>(oper)]);
+    statAdd(counters.n_cmds[static_cast<uint32_t>(oper)], std::max(n_src, n_dst));
+    statAdd(counters.n_bytes[static_cast<uint32_t>(oper)], n_bytes);
+    for (size_t i = 0; i < std::max(src_list.size(), dst_list.size()); i++) {
+        if (i < src_list.size()) {
+            const localSg &sg = src_list[i];
+            bool is_last = last && (i == src_list.size() - 1);
+            for (uint32_t j = 0; j < getNumChunks(sg.len); j++) {
+                uint64_t addr = reinterpret_cast<uint64_t>(sg.addr) + static_cast<uint64_t>(j) * chunk_size;
+                uint32_t len = static_cast<uint32_t>(std::min(sg.len - static_cast<uint64_t>(j) * chunk_size, static_cast<uint64_t>(chunk_size)));
+                executeUnlessCrash([&] {
+                    input_writer.writeMem(addr, len, reinterpret_cast<void *>(addr));
+                    input_writer.invoke((uint8_t) CoyoteOper::LOCAL_READ, sg.stream, sg.dest, addr, len, is_last && (j == getNumChunks(sg.len) - 1));
+                });
+            }
+        }
+        if (i < dst_list.size()) {
+            const localSg &sg = dst_list[i];
+            bool is_last = last && (i == dst_list.size() - 1);
+            for (uint32_t j = 0; j < getNumChunks(sg.len); j++) {
+                uint64_t addr = reinterpret_cast<uint64_t>(sg.addr) + static_cast<uint64_t>(j) * chunk_size;
+                uint32_t len = static_cast<uint32_t>(std::min(sg.len - static_cast<uint64_t>(j) * chunk_size, static_cast<uint64_t>(chunk_size)));
+                executeUnlessCrash([&] {
+                    input_writer.invoke((uint8_t) CoyoteOper::LOCAL_WRITE, sg.stream, sg.dest, addr, len, is_last && (j == getNumChunks(sg.len) - 1));
+                });
+            }
+        }
+    }
+
+    DEBUG("invoke(...) finished")
+    return token;
 }
 
-void cThread::invoke(CoyoteOper oper, rdmaSg sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, rdmaSg sg, bool last) {
     ASSERT("Networking not implemented in simulation target!")
 }
 
-void cThread::invoke(CoyoteOper oper, tcpSg sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, tcpSg sg, bool last) {
+    ASSERT("Networking not implemented in simulation target!")
+}
+
+cmplToken cThread::invokeBatch(CoyoteOper oper, const std::vector<localSg> &sg_list, bool last) {
+    DEBUG("cThread: Call invokeBatch for " << sg_list.size() << " one-sided local operations")
+
+    // In simulation, there is no command FIFO to batch against, so the commands are simply passed one-by-one
+    cmplToken token = CMPL_TOKEN_NONE;
+    for (size_t i = 0; i < sg_list.size(); i++) {
+        token = invoke(oper, sg_list[i], last && (i == sg_list.size() - 1));
+    }
+
+    DEBUG("invokeBatch(...) finished")
+    return token;
+}
+
+cmplToken cThread::invokeBatch(CoyoteOper oper, const std::vector<std::pair<localSg, localSg>> &sg_list, bool last) {
+    DEBUG("cThread: Call invokeBatch for " << sg_list.size() << " two-sided local operations")
+
+    cmplToken token = CMPL_TOKEN_NONE;
+    for (size_t i = 0; i < sg_list.size(); i++) {
+        token = invoke(oper, sg_list[i].first, sg_list[i].second, last && (i == sg_list.size() - 1));
+    }
+
+    DEBUG("invokeBatch(...) finished")
+    return token;
+}
+
+cFuture cThread::invokeAsync(CoyoteOper oper, localSg sg) {
+    // The simulation can only be driven from one thread at a time, so the completion is awaited here instead of in the cReactor
+    cmplToken token = invoke(oper, sg, true);
+    while (!isCompleted(token)) {}
+
+    cPromise promise(token);
+    promise.setReady();
+    return promise.getFuture();
+}
+
+cFuture cThread::invokeAsync(CoyoteOper oper, localSg src_sg, localSg dst_sg) {
+    cmplToken token = invoke(oper, src_sg, dst_sg, true);
+    while (!isCompleted(token)) {}
+
+    cPromise promise(token);
+    promise.setReady();
+    return promise.getFuture();
+}
+
+cFuture cThread::invokeAsync(CoyoteOper oper, rdmaSg sg) {
     ASSERT("Networking not implemented in simulation target!")
 }
 
@@ -393,13 +612,65 @@ uint32_t cThread::checkCompleted(CoyoteOper oper) const {
     return result;
 }
 
+bool cThread::waitCompleted(CoyoteOper oper, uint32_t count, std::chrono::nanoseconds timeout) {
+    if (isRemoteRdma(oper)) {ASSERT("Networking not implemented in simulation target!")}
+    if (isRemoteTcp(oper)) {ASSERT("Networking not implemented in simulation target!")}
+
+    // The simulation blocks until the target is reached; the timeout doesn't apply, since the simulated time differs from the wall-clock time
+    statAdd(counters.n_waits);
+    executeUnlessCrash([&] { 
+        input_writer.checkCompleted((uint8_t) oper, count, true);
+        output_reader.checkCompletedResult();
+    });
+    DEBUG("waitCompleted() finished")
+    return true;
+}
+
+void cThread::setWaitSpin(std::chrono::nanoseconds spin) { wait_spin = spin; }
+
+cmplWaitStats cThread::getWaitStats() const { return counters.getWaitStats(); }
+
 void cThread::clearCompleted() {
+    cmpl_queue.clear();
     executeUnlessCrash([&] { 
         input_writer.clearCompleted();
     });
     DEBUG("clearCompleted() finished")
 }
 
+bool cThread::isCompleted(cmplToken token) {
+    int32_t cls = cCmplQueue::getTokenClass(token);
+    if (cls < 0) {
+        return true;
+    }
+
+    cmpl_queue.update(cls, checkCompleted(cCmplQueue::getClassOper(cls)));
+    return cmpl_queue.isCompleted(token);
+}
+
+void cThread::setCompletionQueue(bool enable) {
+    cmpl_queue.setTracking(enable);
+}
+
+void cThread::setMultiProducer(bool enable) {
+    if (enable) {ASSERT("Multi-producer submission not implemented in simulation target; the simulation can only be driven from one thread")}
+}
+
+uint32_t cThread::pollCompletions(cmplEntry *cmpls, uint32_t n_cmpls) {
+    if (!cmpl_queue.isTracking()) {
+        throw std::runtime_error("ERROR: cThread::pollCompletions() - the completion queue isn't enabled, see setCompletionQueue()");
+    }
+
+    // Only query the simulation for classes with outstanding operations
+    for (uint32_t cls = 0; cls < N_WBACKS; cls++) {
+        if (cmpl_queue.hasPending(cls)) {
+            cmpl_queue.update(cls, checkCompleted(cCmplQueue::getClassOper(cls)));
+        }
+    }
+
+    return cmpl_queue.poll(cmpls, n_cmpls);
+}
+
 void cThread::doArpLookup(uint32_t ip_addr) {
     ASSERT("Networking not implemented in simulation target")
 }
@@ -436,6 +707,44 @@ void cThread::unlock() {
     ASSERT("Scheduling not implemented in simulation target")
 }
 
+void cThread::setBackoff(CoyoteBackoff backoff) {
+    // The simulation has no command FIFO, so the policy is only stored
+    this->backoff = backoff;
+}
+
+cmdStallStats cThread::getStallStats() const { return counters.getStallStats(); }
+
+void cThread::setChunkSize(uint32_t chunk_size) {
+    if (chunk_size == 0 || chunk_size > MAX_TRANSFER_SIZE) {
+        throw std::runtime_error("ERROR: cThread::setChunkSize() - chunk size must be non-zero and at most 128MB, exiting...");
+    }
+    this->chunk_size = chunk_size;
+}
+
+uint32_t cThread::getChunkSize() const { return chunk_size; }
+
+void cThread::setRegCache(bool enable, uint64_t budget) { reg_cache.setEnabled(enable, budget); }
+
+void cThread::invalidateRegCache(const void *addr, uint64_t len) { reg_cache.invalidate(addr, len); }
+
+cRegCacheStats cThread::getRegCacheStats() { return reg_cache.getStats(); }
+
+cThreadStats cThread::getStats() {
+    cThreadStats stats;
+    stats.vfid = vfid;
+    stats.ctid = ctid;
+    counters.snapshot(stats);
+    stats.reg_cache = reg_cache.getStats();
+    return stats;
+}
+
+bool cThread::pinToDevice() {
+    // There is no physical device in simulation, so there is nothing to be close to
+    return false;
+}
+
+int32_t cThread::getNumaNode() const { return numa_node; }
+
 int32_t cThread::getVfid() const { return vfid;};
 
 int32_t cThread::getCtid() const { return ctid; };
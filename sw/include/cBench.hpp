@@ -27,30 +27,208 @@
 #ifndef _COYOTE_CBENCH_HPP_
 #define _COYOTE_CBENCH_HPP_
 
+#include <cmath>
+#include <deque>
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
 #include <vector>
 #include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <pthread.h>
 
 #include "cDefs.hpp"
+#include "cPerf.hpp"
+#include "cTimer.hpp"
+#include "cHistogram.hpp"
 
 namespace coyote {
 
+/// Estimate of a rate (e.g., operations per second), with the bounds of its confidence interval
+struct cBenchInterval {
+    /// Estimated value
+    double avg;
+
+    /// Lower bound of the confidence interval
+    double lo;
+
+    /// Upper bound of the confidence interval; infinite if the interval of the time includes zero
+    double hi;
+};
+
+/**
+ * @brief Cumulative distribution function of Student's t-distribution
+ * @param t Value of the t-statistic
+ * @param dof Degrees of freedom
+ * @return Probability that a t-distributed variable is at most t
+ */
+double studentTCdf(double t, double dof);
+
+/**
+ * @brief Quantile function (inverse of the CDF) of Student's t-distribution
+ * @param p Probability, in (0, 1)
+ * @param dof Degrees of freedom
+ * @return Value t, for which studentTCdf(t, dof) = p
+ */
+double studentTQuantile(double p, double dof);
+
+/**
+ * @brief Welch's t-test, comparing the means of two samples with possibly different variances
+ * @param mean_a, std_dev_a, n_a Mean, sample standard deviation and size of the first sample
+ * @param mean_b, std_dev_b, n_b Mean, sample standard deviation and size of the second sample
+ * @return Two-sided p-value, i.e., the probability of a difference at least this large if the means were equal; NaN if either sample has fewer than two values
+ */
+double welchTTest(double mean_a, double std_dev_a, uint64_t n_a, double mean_b, double std_dev_b, uint64_t n_b);
+
+/// Seed of the random number generator for Poisson arrivals; fixed, so that the arrival schedule is reproducible
+constexpr uint64_t const OPEN_LOOP_SEED = 42;
+
+/// Arrival process of an open-loop benchmark (see cBench::executeOpenLoop)
+enum class cArrivals {
+    CONSTANT,   // Requests are issued at fixed intervals
+    POISSON     // Requests are issued with exponentially distributed intervals, i.e., as independent arrivals
+};
+
+/// One point of a latency-vs-throughput curve, as measured by an open-loop benchmark
+struct cLoadPoint {
+    /// Offered load, i.e., the rate of the arrival schedule, in requests per second
+    double offered_rate;
+
+    /// Achieved throughput, i.e., the number of completed requests over the duration of the benchmark, in requests per second
+    double achieved_rate;
+
+    /// Latency, measured from the intended issue time of every request, in ns
+    double avg_latency;
+    double p50_latency;
+    double p99_latency;
+    double p999_latency;
+    double max_latency;
+};
+
+/// Number of polls of a cSpinBarrier, after which the waiting thread yields its CPU
+constexpr unsigned int const BARRIER_SPINS_PER_YIELD = 1024;
+
+/**
+ * @brief Reusable barrier for a fixed number of threads, which spins instead of blocking
+ *
+ * Spinning keeps the wakeup latency low, so that all the threads of a multi-threaded benchmark start their runs
+ * at (almost) the same time. The barrier can be aborted, e.g., when one of the threads fails, which releases all 
+ * the threads waiting on it, now and in the future.
+ */
+class cSpinBarrier {
+
+private:
+    unsigned int n_threads;
+    std::atomic<unsigned int> n_arrived = { 0 };
+    std::atomic<unsigned int> generation = { 0 };
+    std::atomic<bool> aborted = { false };
+
+public:
+    /// Default constructor; the barrier is released once n_threads threads have arrived
+    explicit cSpinBarrier(unsigned int n_threads): n_threads(n_threads) {}
+
+    /**
+     * @brief Waits until all the threads have arrived at the barrier
+     * @return True once all the threads have arrived; false if the barrier was aborted
+     */
+    bool wait() {
+        unsigned int curr_generation = generation.load(std::memory_order_acquire);
+        if (n_arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == n_threads) {
+            n_arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return !aborted.load(std::memory_order_acquire);
+        }
+
+        // If the CPUs are oversubscribed, the spinning threads yield, so that the remaining ones can arrive
+        for (unsigned int n_spins = 1; generation.load(std::memory_order_acquire) == curr_generation; n_spins++) {
+            if (aborted.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (n_spins % BARRIER_SPINS_PER_YIELD == 0) {
+                std::this_thread::yield();
+            } else {
+                cpuRelax();
+            }
+        }
+        return !aborted.load(std::memory_order_acquire);
+    }
+
+    /// Aborts the barrier; all the current and future calls to wait() return false
+    void abort() { aborted.store(true, std::memory_order_release); }
+};
+
 /**
  * @brief Helper class for benchmarking various functions in Coyote
  *
  * At a high-level, it executes some function a number of times and records its duration
  * Then, it can be used for outputting run-time statistics, such as average, minimum, maximum etc.
+ * The durations are recorded (in ns) in a cHistogram, so the memory use doesn't grow with the number of runs
+ * and the results of multiple benchmarks (e.g., from multiple threads or processes) can be merged.
+ * The durations are measured with the time-stamp counter (see cTimer), and the overhead of the timer itself
+ * is subtracted from them, so that sub-microsecond operations (e.g., setCSR) can be benchmarked accurately.
  */
 class cBench {
 
 private:
     unsigned int n_runs;
     unsigned int n_warmups;
-    std::vector<double> measured_times;
-    
+    cHistogram measured_times;
+
+    /// Number of threads of the last benchmark; only executeThreads() runs more than one
+    unsigned int n_threads = { 1 };
+
+    /// Times of the individual threads and wall-clock times of the runs of a multi-threaded benchmark (see executeThreads)
+    std::vector<cHistogram> thread_times;
+    cHistogram run_times;
+
+    /// Bytes moved and operations completed by every iteration of the benchmarked function (see setWork)
+    uint64_t n_bytes = { 0 };
+    uint64_t n_ops = { 1 };
+
+    /// Overhead of an empty timed region, in timer ticks (see cTimer::getOverhead)
+    uint64_t timer_overhead;
+
+    /// Whether the hardware performance counters are captured around every run (see setPerfCounters)
+    bool perf_enabled = { false };
+
+    /// Counts of the performance counters over all the measured runs, and the number of iterations these include
+    cPerfCounts perf_counts;
+    uint64_t perf_iters = { 0 };
+
+    /// Utility function, clearing the results of the previous benchmark
+    void clearResults();
+
+    /// Utility function, returning the duration of a timed region, in ns, without the overhead of the timer
+    double getElapsed(uint64_t begin, uint64_t end) const {
+        uint64_t ticks = end - begin;
+        return cTimer::toNs(ticks > timer_overhead ? ticks - timer_overhead : 0);
+    }
+
 public:
-    /// Default constructor; user can define number of test runs and also the number of warm-up runs, which don't affect time measurements
-    cBench(unsigned int n_runs = 1000, unsigned int n_warmups = 100);
+    /**
+     * @brief Default constructor; user can define number of test runs and also the number of warm-up runs, which don't affect time measurements
+     * @param precision Precision of the recorded times, in significant bits (see cHistogram)
+     */
+    cBench(unsigned int n_runs = 1000, unsigned int n_warmups = 100, uint32_t precision = HIST_DEFAULT_PRECISION);
+
+    /**
+     * @brief Declares the work done by every iteration of the benchmarked function, which is used for the throughput (see getOpsPerSec)
+     * @param n_bytes Bytes moved by every iteration (e.g., the transfer size times the number of transfers)
+     * @param n_ops Operations completed by every iteration (default: 1)
+     */
+    void setWork(uint64_t n_bytes, uint64_t n_ops = 1);
+
+    /**
+     * @brief Enables or disables capturing the hardware performance counters of the benchmarked function (see cPerf)
+     *
+     * When enabled, the counters of the benchmarking thread(s) are only enabled around the measured runs, excluding 
+     * the warm-up runs and the prep function, and reported per iteration (see getPerfCounter). Enabling and disabling 
+     * the counters happens outside of the timed region, but adds a few system calls to every run.
+     */
+    void setPerfCounters(bool enable);
 
     /**
      * Benchmark function execution (measure the duration)
@@ -71,7 +249,8 @@ public:
     template <class BenchFunc, typename... BenchArgs, class PrepFunc, typename... PrepArgs>
     void execute(BenchFunc const &bench_func, BenchArgs... bench_args, PrepFunc const &prep_func, PrepArgs... prep_args) {
         // Clear previous results
-        measured_times.clear();
+        clearResults();
+        std::unique_ptr<cPerf> perf(perf_enabled ? new cPerf() : nullptr);
 
         // Run a few warm-up runs; this is particularly useful for AVX architectures and code running on GPUs
         for (int i = 0; i < this->n_warmups; i++) {
@@ -83,40 +262,367 @@ public:
         for (int i = 0; i < this->n_runs; i++) {
             // Calculate elapsed time - start timer, execute the function (which is given as an argument) and stop timer afterwards 
             prep_func(prep_args...);
-            auto begin_time = std::chrono::high_resolution_clock::now();
+            if (perf) { perf->enable(); }
+            uint64_t begin_time = cTimer::start();
             bench_func(bench_args...);
-            auto end_time = std::chrono::high_resolution_clock::now();
-            double measured_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count();
-            measured_times.emplace_back(measured_time);
+            uint64_t end_time = cTimer::stop();
+            if (perf) { perf->disable(); }
+            double measured_time = getElapsed(begin_time, end_time);
+            measured_times.record((uint64_t) std::llround(measured_time));
+        }
+
+        if (perf) {
+            perf_counts = perf->read();
+            perf_iters = this->n_runs;
+        }
+    }
+
+    /**
+     * Benchmark the throughput of a function, which is issued asynchronously, with multiple iterations in flight
+     *
+     * Every run issues n_iters iterations of the benchmarked function, keeping up to n_in_flight of them outstanding:
+     * once the limit is reached, the oldest iteration is waited for before the next one is issued. The run time is 
+     * divided by n_iters, so that, as for execute(), all the statistics refer to a single iteration; the percentiles
+     * are of the average iteration time in every run. Together with the work of every iteration (see setWork),
+     * these give the throughput, e.g., with n_in_flight transfers outstanding at any time.
+     *
+     * @param n_iters Number of iterations per run
+     * @param n_in_flight Maximum number of outstanding iterations; 1 waits for every iteration before issuing the next one
+     * @param issue_func Function issuing an iteration, without waiting for it; called with the index of the iteration in the run
+     * @param wait_func Function waiting for an iteration to complete; called with the index of the iteration, in issue order
+     * @param prep_func Function executed before every run (any prep work, e.g., clearing the completion counters)
+     */
+    template <class IssueFunc, class WaitFunc, class PrepFunc>
+    void executeThroughput(
+        unsigned int n_iters, unsigned int n_in_flight, 
+        IssueFunc const &issue_func, WaitFunc const &wait_func, PrepFunc const &prep_func
+    ) {
+        if (n_iters == 0 || n_in_flight == 0) {
+            throw std::runtime_error("ERROR: cBench::executeThroughput() - the number of iterations and iterations in flight must be positive");
+        }
+
+        clearResults();
+        std::unique_ptr<cPerf> perf(perf_enabled ? new cPerf() : nullptr);
+
+        auto run = [&]() {
+            unsigned int n_issued = 0;
+            for (unsigned int n_done = 0; n_done < n_iters; n_done++) {
+                while (n_issued < n_iters && n_issued - n_done < n_in_flight) {
+                    issue_func(n_issued++);
+                }
+                wait_func(n_done);
+            }
+        };
+
+        for (unsigned int i = 0; i < this->n_warmups; i++) {
+            prep_func();
+            run();
+        }
+
+        for (unsigned int i = 0; i < this->n_runs; i++) {
+            prep_func();
+            if (perf) { perf->enable(); }
+            uint64_t begin_time = cTimer::start();
+            run();
+            uint64_t end_time = cTimer::stop();
+            if (perf) { perf->disable(); }
+            double measured_time = getElapsed(begin_time, end_time);
+            measured_times.record((uint64_t) std::llround(measured_time / (double) n_iters));
+        }
+
+        if (perf) {
+            perf_counts = perf->read();
+            perf_iters = (uint64_t) this->n_runs * n_iters;
+        }
+    }
+
+    /**
+     * Benchmark a function on multiple threads at once, e.g., to measure the scaling with the number of cThreads on one vFPGA
+     *
+     * Each of the n_threads worker threads is (optionally) pinned to a CPU and executes the benchmarked function with its 
+     * own thread ID, e.g., to use its own cThread. Every run is started on all the threads at the same time, from a spin 
+     * barrier, and finishes once all the threads are done; so, the threads contend for the vFPGA for the entire run.
+     * The times of every thread are recorded separately (see getThreadHistogram) and merged for the latency statistics
+     * (getAvg, getP50 etc.); the aggregate throughput (getOpsPerSec etc.) is the work of all the threads over the wall-clock
+     * time of the runs.
+     *
+     * @param n_threads Number of worker threads
+     * @param bench_func Function to be benchmarked; called with the ID of the thread (from 0 to n_threads - 1)
+     * @param prep_func Function executed by every thread before every run (any prep work); called with the ID of the thread
+     * @param cpus CPUs to pin the threads to; thread i is pinned to cpus[i % cpus.size()]. If empty, the threads aren't pinned
+     *
+     * @note If the function throws on any of the threads, the benchmark is stopped and the (first) exception is rethrown
+     */
+    template <class BenchFunc, class PrepFunc>
+    void executeThreads(
+        unsigned int n_threads, BenchFunc const &bench_func, PrepFunc const &prep_func, 
+        const std::vector<uint32_t> &cpus = std::vector<uint32_t>()
+    ) {
+        if (n_threads == 0) {
+            throw std::runtime_error("ERROR: cBench::executeThreads() - the number of threads must be positive");
+        }
+
+        clearResults();
+        this->n_threads = n_threads;
+        thread_times.assign(n_threads, cHistogram(measured_times.getPrecision()));
+
+        cSpinBarrier barrier(n_threads);
+        std::vector<std::exception_ptr> errors(n_threads);
+        std::vector<cPerfCounts> thread_perf_counts(n_threads);
+        std::vector<std::thread> workers;
+
+        auto worker = [&](unsigned int tid) {
+            try {
+                if (!cpus.empty()) {
+                    cpu_set_t cpu_set;
+                    CPU_ZERO(&cpu_set);
+                    CPU_SET(cpus[tid % cpus.size()], &cpu_set);
+                    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+                        throw std::runtime_error("ERROR: cBench::executeThreads() - could not pin thread " + std::to_string(tid));
+                    }
+                }
+
+                // Every thread counts its own events, so the counters are opened by the worker itself
+                std::unique_ptr<cPerf> perf(perf_enabled ? new cPerf() : nullptr);
+
+                uint64_t run_begin = 0;
+                for (unsigned int i = 0; i < this->n_warmups + this->n_runs; i++) {
+                    bool measured = i >= this->n_warmups;
+                    prep_func(tid);
+                    if (!barrier.wait()) { return; }
+
+                    if (perf && measured) { perf->enable(); }
+                    uint64_t begin_time = cTimer::start();
+                    if (tid == 0) { run_begin = begin_time; }
+                    bench_func(tid);
+                    uint64_t end_time = cTimer::stop();
+                    if (perf && measured) { perf->disable(); }
+
+                    // Only the first thread records the wall-clock time of the run, once the other threads are done too
+                    if (measured) {
+                        thread_times[tid].record((uint64_t) std::llround(getElapsed(begin_time, end_time)));
+                    }
+                    if (!barrier.wait()) { return; }
+                    if (measured && tid == 0) {
+                        uint64_t run_end = cTimer::stop();
+                        run_times.record((uint64_t) std::llround(getElapsed(run_begin, run_end)));
+                    }
+                }
+
+                if (perf) { thread_perf_counts[tid] = perf->read(); }
+            } catch (...) {
+                errors[tid] = std::current_exception();
+                barrier.abort();
+            }
+        };
+
+        for (unsigned int i = 0; i < n_threads; i++) {
+            workers.emplace_back(worker, i);
+        }
+        for (auto &w : workers) {
+            w.join();
+        }
+
+        for (auto &e : errors) {
+            if (e) { std::rethrow_exception(e); }
+        }
+
+        for (auto &t : thread_times) {
+            measured_times.merge(t);
+        }
+
+        if (perf_enabled) {
+            for (auto &c : thread_perf_counts) {
+                perf_counts += c;
+            }
+            perf_iters = (uint64_t) this->n_runs * n_threads;
+        }
+    }
+
+    /**
+     * Benchmark the latency of requests issued in an open loop, i.e., on a fixed arrival schedule rather than after the previous one completed
+     *
+     * In a closed loop, a slow request delays the issue of the next ones, so the queueing delay is hidden (coordinated omission).
+     * Here, n_warmups + n_runs requests are issued on a schedule with the given rate, regardless of their completions; 
+     * if the issue function blocks (e.g., on a full command FIFO), the following requests are issued late, but back-to-back.
+     * The latency of every request is measured from its intended issue time, i.e., it includes the time the request waited 
+     * to be issued. The latencies of the last n_runs requests are recorded, so getAvg(), getP99() etc. refer to them.
+     *
+     * @param rate Offered load, in requests per second
+     * @param arrivals Arrival process; constant intervals or Poisson arrivals
+     * @param issue_func Function issuing a request, without waiting for it; called with the index of the request
+     * @param poll_func Function returning the number of completed requests so far; requests must complete in issue order
+     * @param prep_func Function executed once before the first request (any prep work, e.g., clearing the completion counters)
+     * @return Offered load, achieved throughput and latency of the benchmark
+     *
+     * @note The throughput getters (getOpsPerSec etc.) don't apply to open-loop benchmarks; use the returned achieved rate instead
+     * Similarly, the performance counters aren't captured, since the requests overlap and there's no timed region per request
+     */
+    template <class IssueFunc, class PollFunc, class PrepFunc>
+    cLoadPoint executeOpenLoop(
+        double rate, cArrivals arrivals, IssueFunc const &issue_func, PollFunc const &poll_func, PrepFunc const &prep_func
+    ) {
+        if (rate <= 0) {
+            throw std::runtime_error("ERROR: cBench::executeOpenLoop() - the offered load must be positive");
         }
 
-        // Sort the results after logging to a file; enables easier calculation of the statistics below
-        std::sort(measured_times.begin(), measured_times.end());
+        clearResults();
+
+        std::mt19937_64 rand_gen(OPEN_LOOP_SEED);
+        std::exponential_distribution<double> exp_distr(rate);
+        auto next_interval = [&]() {
+            return arrivals == cArrivals::POISSON ? exp_distr(rand_gen) * 1e9 : 1e9 / rate;
+        };
+
+        // Intended issue times of the outstanding requests, in ns since the start of the benchmark
+        std::deque<double> intended_times;
+        uint64_t n_requests = (uint64_t) this->n_warmups + this->n_runs;
+        uint64_t n_issued = 0, n_completed = 0;
+        double next_time = 0;
+
+        prep_func();
+        uint64_t begin_time = cTimer::now();
+        auto elapsed = [&]() {
+            return cTimer::toNs(cTimer::now() - begin_time);
+        };
+
+        while (n_completed < n_requests) {
+            // Issue all the requests whose time has come; if the issue was delayed, the late ones are issued back-to-back
+            bool progress = false;
+            while (n_issued < n_requests && elapsed() >= next_time) {
+                intended_times.push_back(next_time);
+                issue_func(n_issued++);
+                next_time += next_interval();
+                progress = true;
+            }
+
+            uint64_t n_done = std::min((uint64_t) poll_func(), n_issued);
+            if (n_done > n_completed) {
+                double curr_time = elapsed();
+                for (; n_completed < n_done; n_completed++) {
+                    if (n_completed >= this->n_warmups) {
+                        measured_times.record((uint64_t) std::llround(curr_time - intended_times.front()));
+                    }
+                    intended_times.pop_front();
+                }
+                progress = true;
+            }
+
+            if (!progress) {
+                cpuRelax();
+            }
+        }
+
+        double total_time = elapsed();
+        return { 
+            rate, (double) n_requests * 1e9 / total_time, 
+            getAvg(), getP50(), getP99(), getPercentile(99.9), getMax() 
+        };
+    }
+
+    /**
+     * Sweeps the offered load of an open-loop benchmark (see executeOpenLoop), to obtain a latency-vs-throughput curve
+     *
+     * @param rates Offered loads, in requests per second
+     * @return One point of the curve per offered load; the recorded times (getAvg() etc.) refer to the last one
+     */
+    template <class IssueFunc, class PollFunc, class PrepFunc>
+    std::vector<cLoadPoint> executeLoadSweep(
+        const std::vector<double> &rates, cArrivals arrivals, 
+        IssueFunc const &issue_func, PollFunc const &poll_func, PrepFunc const &prep_func
+    ) {
+        std::vector<cLoadPoint> curve;
+        for (double rate : rates) {
+            curve.push_back(executeOpenLoop(rate, arrivals, issue_func, poll_func, prep_func));
+        }
+        return curve;
     }
     
     /// Returns the mean execution time; averaged over n_runs
-    double getAvg();
+    double getAvg() const;
 
     /// Returns the minimum execution time out of the n_runs recorded times
-    double getMin();
+    double getMin() const;
 
     /// Returns the maximum execution time out of the n_runs recorded times
-    double getMax();
+    double getMax() const;
 
     /// Returns the P25 execution time out of the n_runs recorded times
-    double getP25();
+    double getP25() const;
 
     /// Returns the P50 execution time out of the n_runs recorded times
-    double getP50();
+    double getP50() const;
 
     /// Returns the P75 execution time out of the n_runs recorded times
-    double getP75();
+    double getP75() const;
 
     /// Returns the P95 execution time out of the n_runs recorded times
-    double getP95();
+    double getP95() const;
 
     /// Returns the P99 execution time out of the n_runs recorded times
-    double getP99();
+    double getP99() const;
+
+    /// Returns an arbitrary percentile (between 0 and 100, e.g., 99.99) of the n_runs recorded times
+    double getPercentile(double percentile) const;
+
+    /// Returns the histogram of the recorded times, e.g., for merging the results of multiple benchmarks or serializing them
+    const cHistogram& getHistogram() const;
+
+    /// Returns the sample standard deviation of the n_runs recorded times
+    double getStdDev() const;
+
+    /**
+     * @brief Returns the number of operations per second, with its confidence interval
+     *
+     * The interval is obtained from the confidence interval of the mean time per iteration (using Student's t-distribution),
+     * so that the rate is the total work over the total time, rather than an average of per-run rates
+     * For multi-threaded benchmarks (see executeThreads), the rate is aggregated over all the threads, using the wall-clock time of the runs
+     *
+     * @param confidence Confidence level of the interval (default: 0.95)
+     */
+    cBenchInterval getOpsPerSec(double confidence = 0.95) const;
+
+    /// Returns the number of bytes per second, with its confidence interval (see getOpsPerSec)
+    cBenchInterval getBytesPerSec(double confidence = 0.95) const;
+
+    /// Returns the bandwidth in GB/s (10^9 bytes per second), with its confidence interval (see getOpsPerSec)
+    cBenchInterval getGBPerSec(double confidence = 0.95) const;
+
+    /**
+     * @brief Returns the average count of a hardware event per iteration of the last benchmark (see setPerfCounters)
+     *
+     * For multi-threaded benchmarks (see executeThreads), the counts are summed over all the threads and divided by 
+     * the iterations of all the threads; for executeThroughput, they are divided by the iterations of every run.
+     *
+     * @return Count per iteration; NaN if the counters weren't captured or the event couldn't be counted
+     */
+    double getPerfCounter(cPerfEvent event) const;
+
+    /// Returns the counts of the hardware events, summed over all the measured runs (and threads) of the last benchmark
+    const cPerfCounts& getPerfCounts() const;
+
+    /// Returns the overhead of the timer, in ns, which is subtracted from every recorded time
+    double getTimerOverhead() const;
+
+    /**
+     * @brief Converts the mean of the given times (in ns) and its confidence interval to a rate, e.g., for times measured outside of cBench
+     * @param times Times per iteration, in ns
+     * @param work Work done by every iteration, e.g., bytes or operations
+     * @param confidence Confidence level of the interval
+     */
+    static cBenchInterval getRate(const cHistogram &times, double work, double confidence = 0.95);
+
+    /// Returns the number of threads of the last benchmark; one, unless executeThreads() was used
+    unsigned int getNumThreads() const;
+
+    /// Returns the histogram of the times recorded by one thread of a multi-threaded benchmark (see executeThreads)
+    const cHistogram& getThreadHistogram(unsigned int tid) const;
+
+    /// Returns the number of operations per second of one thread of a multi-threaded benchmark, with its confidence interval
+    cBenchInterval getThreadOpsPerSec(unsigned int tid, double confidence = 0.95) const;
+
+    /// Returns the number of bytes per second of one thread of a multi-threaded benchmark, with its confidence interval
+    cBenchInterval getThreadBytesPerSec(unsigned int tid, double confidence = 0.95) const;
 };
 }
 
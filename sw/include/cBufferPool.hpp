@@ -0,0 +1,217 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CBUFFERPOOL_HPP_
+#define _COYOTE_CBUFFERPOOL_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+
+namespace coyote {
+
+class cThread;
+struct cThreadCaches;
+
+/// Smallest size class of the buffer pool (64 B, i.e., one cache line)
+constexpr uint32_t const BPOOL_MIN_SHIFT = 6;
+
+/// Size of a slab; every slab holds buffers of a single size class and the largest size class is one slab (2 MB, i.e., one huge page)
+constexpr uint32_t const BPOOL_SLAB_SHIFT = 21;
+constexpr uint32_t const BPOOL_SLAB_SIZE = 1 << BPOOL_SLAB_SHIFT;
+
+/// Number of size classes: 64 B, 128 B, ..., 2 MB
+constexpr uint32_t const BPOOL_N_CLASSES = BPOOL_SLAB_SHIFT - BPOOL_MIN_SHIFT + 1;
+
+/// Default size of a region, reserved with a single cThread::getMem call
+constexpr uint32_t const BPOOL_REGION_SIZE = 32 * 1024 * 1024;
+
+/// Maximum number of regions per pool
+constexpr uint32_t const BPOOL_MAX_REGIONS = 1024;
+
+/// Maximum number of buffers per size class in a thread-local cache; once exceeded, half of them are returned to the pool
+constexpr uint32_t const BPOOL_CACHE_SIZE = 64;
+
+/// @brief Statistics of a cBufferPool
+struct cBufferPoolStats {
+    /// Number of regions reserved from the cThread (i.e., getMem calls for regions)
+    uint64_t n_regions = { 0 };
+
+    /// Total memory reserved for regions, in bytes
+    uint64_t reserved_bytes = { 0 };
+
+    /// Number of slabs carved from the regions
+    uint64_t n_slabs = { 0 };
+
+    /// Number of times a thread-local cache was refilled from, or flushed to, the shared free lists
+    uint64_t n_refills = { 0 };
+    uint64_t n_flushes = { 0 };
+
+    /// Number of allocations larger than a slab, which are served directly by cThread::getMem
+    uint64_t n_large = { 0 };
+};
+
+/**
+ * @brief Pool of pre-mapped buffers, sub-allocated from large regions obtained with cThread::getMem
+ *
+ * Every call to getMem maps (and pins) new memory in the driver and every call to freeMem unmaps it again,
+ * which is expensive and invalidates the vFPGA TLB. Instead, this pool reserves large regions once and hands out 
+ * sub-allocations, which are already mapped for the vFPGA; freed buffers are returned to the pool, without 
+ * any driver interaction. Memory is only released to the driver when the pool is destroyed.
+ *
+ * Regions are split into slabs of 2 MB, each holding buffers of a single, power-of-two, size class (64 B - 2 MB).
+ * Therefore, buffers are aligned to their size class (e.g., a 4 KB buffer is page-aligned). Each thread has a small 
+ * local cache of free buffers per size class, so that most allocations and frees don't need any synchronization.
+ * When a thread exits, its cached buffers are returned to the pools that still exist; a long-lived thread, which stops 
+ * using a pool, can return them earlier with flushThreadCache(). Allocations larger than a slab (up to 4 GB) are 
+ * passed through to cThread::getMem and cThread::freeMem.
+ *
+ * @note The pool uses the cThread for mapping memory; the cThread must outlive the pool.
+ * The pool itself can be used concurrently, as long as the cThread isn't used for getMem/freeMem concurrently by others.
+ */
+class cBufferPool {
+
+    friend struct cThreadCaches;
+
+private:
+    /// A region, reserved with cThread::getMem
+    struct cRegion {
+        /// Start of the region
+        char *base = { nullptr };
+
+        /// Size class of every slab in the region, or -1 if the slab hasn't been carved yet
+        std::vector<int8_t> slab_class;
+
+        /// Number of slabs carved so far; slabs are carved in order
+        uint32_t n_carved = { 0 };
+    };
+
+    /// Unique ID of this pool; used to key the thread-local caches
+    const uint64_t pool_id;
+
+    /// cThread used for mapping the memory
+    cThread &thread;
+
+    /// Type of memory used for the regions (HPF or THP)
+    const CoyoteAllocType alloc_type;
+
+    /// Size of every region
+    const uint32_t region_size;
+
+    /**
+     * Reserved regions; the array is pre-allocated and regions are only appended, so that 
+     * free() can look up the region of a buffer without holding the lock
+     */
+    std::unique_ptr<cRegion[]> regions;
+
+    /// Number of reserved regions; published after the region is fully initialized
+    std::atomic<uint32_t> n_regions = { 0 };
+
+    /// Protects all the fields below, as well as carving slabs in the regions
+    std::mutex mtx;
+
+    /// First region which may still have slabs that haven't been carved
+    uint32_t curr_region = { 0 };
+
+    /// Shared free lists, one per size class
+    std::vector<void*> free_lists[BPOOL_N_CLASSES];
+
+    /// Allocations larger than a slab, served directly by cThread::getMem, and their sizes
+    std::unordered_map<void*, size_t> large_allocs;
+
+    /// Statistics
+    cBufferPoolStats stats;
+
+    /// Utility function, returns the size class for a given size
+    static uint32_t getClass(size_t size);
+
+    /// Utility function, returns the thread-local cache of this pool, for each size class
+    std::vector<void*>* getCache();
+
+    /// Returns the buffers of a thread-local cache (one vector per size class) to the shared free lists
+    void returnCache(std::vector<void*> *cache);
+
+    /// Reserves a new region; must be called with the lock held
+    cRegion& reserveRegion();
+
+    /// Carves a new slab for the given size class and adds its buffers to the shared free list; must be called with the lock held
+    void carveSlab(uint32_t cls);
+
+    /// Returns the region containing the pointer, or nullptr if the pointer isn't from any region; doesn't need the lock
+    cRegion* findRegion(const void *ptr) const;
+
+public:
+    /**
+     * @brief Creates a new, empty, buffer pool; regions are only reserved on demand (or with reserve())
+     *
+     * @param thread cThread, used for mapping the regions to the vFPGA
+     * @param region_size Size of a region; must be a multiple of the slab size (2 MB)
+     * @param alloc_type Type of memory used for the regions; must be CoyoteAllocType::HPF or CoyoteAllocType::THP
+     */
+    cBufferPool(cThread &thread, uint32_t region_size = BPOOL_REGION_SIZE, CoyoteAllocType alloc_type = CoyoteAllocType::HPF);
+
+    /// Releases all the regions to the driver; any buffers still in use become invalid
+    ~cBufferPool();
+
+    cBufferPool(const cBufferPool&) = delete;
+    cBufferPool& operator=(const cBufferPool&) = delete;
+
+    /// Reserves (and maps) regions upfront, with a total size of at least the given number of bytes
+    void reserve(uint64_t bytes);
+
+    /**
+     * @brief Allocates a buffer from the pool
+     *
+     * @param size Size of the buffer in bytes; rounded up to the next power of two (at least 64 B)
+     * @return Pointer to the buffer, which is mapped to the vFPGA and aligned to its size class (up to 2 MB)
+     * @throws std::runtime_error if the size exceeds 4 GB (the largest getMem allocation) or the memory can't be allocated
+     */
+    void* alloc(size_t size);
+
+    /// Returns a buffer, obtained with alloc(), to the pool
+    void free(void *ptr);
+
+    /// Returns the free buffers, cached by the calling thread, to the shared free lists; e.g., before a worker thread goes idle
+    void flushThreadCache();
+
+    /// Returns the usable size of a buffer, obtained with alloc(), i.e., the size of its size class
+    size_t getSize(const void *ptr);
+
+    /// Returns true if the pointer points to a buffer allocated from this pool
+    bool owns(const void *ptr);
+
+    /// Returns the statistics of the pool
+    cBufferPoolStats getStats();
+};
+
+}
+
+#endif // _COYOTE_CBUFFERPOOL_HPP_
@@ -0,0 +1,156 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CCMPLQUEUE_HPP_
+#define _COYOTE_CCMPLQUEUE_HPP_
+
+#include <memory>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+
+namespace coyote {
+
+/// Number of bits in a completion token used for the completion class; the remaining bits hold the sequence number
+constexpr uint32_t const CMPL_CLASS_BITS = 4;
+constexpr uint64_t const CMPL_SEQ_MASK = (1ULL << (64 - CMPL_CLASS_BITS)) - 1;
+
+/// Maximum number of issued, but not yet polled, completions per class, when tracking is enabled (must be a power of two)
+constexpr uint32_t const CMPL_QUEUE_DEPTH = 64 * 1024;
+
+/**
+ * @brief Software completion queue, built on top of the (aggregate) completion counters of a cThread
+ *
+ * The hardware only exposes a monotonically increasing completion counter per operation class 
+ * (local read, local write, RDMA read, RDMA write), which is incremented for every command flagged as last.
+ * This class assigns every such command a sequence number in its class and keeps track of the issued commands.
+ * Once the (32-bit) hardware counter for the class reaches the sequence number, the command is completed.
+ * The classes correspond to the writeback indices (RD_WBACK, WR_WBACK, RD_RDMA_WBACK, WR_RDMA_WBACK).
+ * Tokens and isCompleted() are always available; keeping the issued commands for poll() is opt-in (see setTracking), 
+ * so that users which never poll don't pay for it.
+ *
+ * @note This class is independent of the hardware; the counters are read by the cThread and passed to update()
+ */
+class cCmplQueue {
+
+private:
+    /// Sequence number of the last issued command, per class
+    uint64_t issued[N_WBACKS] = { 0 };
+
+    /// Number of completed commands, per class; 64-bit extension of the 32-bit hardware counters
+    uint64_t completed[N_WBACKS] = { 0 };
+
+    /// Last observed value of the hardware counter, per class
+    uint32_t hw_cnt[N_WBACKS] = { 0 };
+
+    /// Whether the issued commands are kept for poll()
+    bool tracking = { false };
+
+    /// Issued commands which haven't been returned by poll() yet, per class, in issue order; 
+    /// ring buffers of CMPL_QUEUE_DEPTH entries, only allocated while tracking is enabled
+    std::unique_ptr<cmplEntry[]> pending[N_WBACKS];
+
+    /// Position of the oldest pending command and the next free position of every ring
+    uint64_t pending_head[N_WBACKS] = { 0 };
+    uint64_t pending_tail[N_WBACKS] = { 0 };
+
+public:
+    /**
+     * @brief Returns the completion class of an operation, as the index of its writeback counter
+     * @return Class index, or -1 if the operation isn't tracked by the completion counters
+     */
+    static int32_t getClass(CoyoteOper oper);
+
+    /// Returns the operation whose completion counter (see cThread::checkCompleted) corresponds to the class
+    static CoyoteOper getClassOper(uint32_t cls);
+
+    /// Returns the completion class encoded in a token, or -1 for CMPL_TOKEN_NONE
+    static int32_t getTokenClass(cmplToken token);
+
+    /**
+     * @brief Assigns a token to a command that is about to be posted
+     *
+     * Commands flagged as last get the next sequence number in their class and, if tracking is enabled, are queued for poll().
+     * Other commands return the token of the next command flagged as last in the same class, 
+     * since the counter is only incremented once the entire sequence of commands is completed.
+     *
+     * @param oper Operation of the command
+     * @param last Whether the command is flagged as last
+     * @return Token of the command; CMPL_TOKEN_NONE for operations without completion tracking
+     * @throws std::runtime_error if tracking is enabled and CMPL_QUEUE_DEPTH commands of the class haven't been polled yet; 
+     * the command isn't issued then, so it can be retried after polling
+     */
+    cmplToken issue(CoyoteOper oper, bool last);
+
+    /**
+     * @brief Updates the number of completed commands of a class
+     * @param cls Completion class
+     * @param cnt Current value of the hardware completion counter for the class
+     */
+    void update(uint32_t cls, uint32_t cnt);
+
+    /// Returns true if the class has issued commands that haven't been polled yet
+    bool hasPending(uint32_t cls) const;
+
+    /// Checks whether the command with the given token is completed, given the last update()
+    bool isCompleted(cmplToken token) const;
+
+    /**
+     * @brief Checks whether the command with the given token is completed, directly from a hardware counter value
+     *
+     * Unlike the other functions, this one doesn't depend on the state of the queue, so it can be used by
+     * other threads (e.g., cReactor) without synchronization, as long as there are less than 2^31 outstanding commands in the class.
+     *
+     * @param token Token of the command
+     * @param cnt Current value of the hardware completion counter for the token's class
+     */
+    static bool isCompleted(cmplToken token, uint32_t cnt);
+
+    /**
+     * @brief Drains completed commands from the queue, in issue order within every class
+     * @param cmpls Array to be filled with the completed commands
+     * @param n_cmpls Maximum number of entries to be written
+     * @return Number of entries written to cmpls
+     */
+    uint32_t poll(cmplEntry *cmpls, uint32_t n_cmpls);
+
+    /// Resets all the sequence numbers and drops the pending commands; must be called when the hardware counters are cleared
+    void clear();
+
+    /**
+     * @brief Enables or disables keeping the issued commands for poll()
+     *
+     * Only commands issued while tracking is enabled are returned by poll(); disabling it drops the pending commands.
+     */
+    void setTracking(bool enable);
+
+    /// Returns true if the issued commands are kept for poll()
+    bool isTracking() const;
+};
+
+}
+
+#endif // _COYOTE_CCMPLQUEUE_HPP_
@@ -0,0 +1,298 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CCORO_HPP_
+#define _COYOTE_CCORO_HPP_
+
+/*
+ * C++20 coroutine support for Coyote data movement
+ *
+ * The Coyote library itself is built with C++17; therefore, everything in this file is header-only
+ * and only available when the including application is compiled with C++20 (or newer).
+ */
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <deque>
+#include <vector>
+#include <utility>
+#include <exception>
+#include <coroutine>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+#include "cThread.hpp"
+
+namespace coyote {
+
+class cExecutor;
+
+/**
+ * @brief A coroutine, which can be spawned on a cExecutor or awaited from another cCoroTask
+ *
+ * The coroutine is lazy, i.e., it doesn't start executing until it's spawned or awaited.
+ * Any exception thrown from the coroutine is propagated to the awaiting coroutine or, 
+ * for spawned coroutines, re-thrown by cExecutor::run().
+ */
+class cCoroTask {
+
+public:
+    struct promise_type {
+        /// Coroutine awaiting this one, if any; resumed once this one completes
+        std::coroutine_handle<> continuation = { nullptr };
+
+        /// Exception thrown from the coroutine, if any
+        std::exception_ptr exc = { nullptr };
+
+        cCoroTask get_return_object() { return cCoroTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        /// On completion, transfer control to the awaiting coroutine (if any) without growing the stack
+        auto final_suspend() noexcept {
+            struct final_awaiter {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                    std::coroutine_handle<> next = h.promise().continuation;
+                    return next ? next : std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            return final_awaiter{};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() { exc = std::current_exception(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle = { nullptr };
+
+    friend class cExecutor;
+
+public:
+    explicit cCoroTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    cCoroTask(cCoroTask &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    cCoroTask(const cCoroTask&) = delete;
+    cCoroTask& operator=(const cCoroTask&) = delete;
+
+    ~cCoroTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /// Awaiting a task starts it and suspends the awaiting coroutine until the task completes
+    auto operator co_await() noexcept {
+        struct task_awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            void await_resume() {
+                if (handle.promise().exc) {
+                    std::rethrow_exception(handle.promise().exc);
+                }
+            }
+        };
+        return task_awaiter{ handle };
+    }
+};
+
+/**
+ * @brief Single-threaded executor for coroutines performing Coyote operations
+ *
+ * Coroutines are spawned on the executor and run by run(), on the calling thread. Whenever a coroutine awaits
+ * a Coyote operation, it's suspended and the executor resumes it once the operation's completion token is completed.
+ * Therefore, many independent operations can be outstanding per CPU core, without any blocked threads.
+ *
+ * @note The executor and all the cThreads used by its coroutines must only be used from the thread calling run()
+ */
+class cExecutor {
+
+private:
+    /// A coroutine suspended on a Coyote operation
+    struct cWaiter {
+        cThread *thread;
+        cmplToken token;
+        std::coroutine_handle<> handle;
+    };
+
+    /// Coroutines which can be resumed
+    std::deque<std::coroutine_handle<>> ready;
+
+    /// Coroutines suspended on Coyote operations
+    std::vector<cWaiter> waiting;
+
+    /// Spawned (top-level) coroutines, owned by the executor
+    std::vector<cCoroTask> tasks;
+
+    /// Executor running on the current thread, if any; used by the awaitables to register themselves
+    static inline thread_local cExecutor *curr = nullptr;
+
+public:
+    /// Returns the executor running on the calling thread, or nullptr if there is none
+    static cExecutor* current() { return curr; }
+
+    /// Spawns a coroutine; it starts executing on the next call to run()
+    void spawn(cCoroTask &&task) {
+        ready.push_back(task.handle);
+        tasks.emplace_back(std::move(task));
+    }
+
+    /// Suspends a coroutine until the operation with the given token is completed; called by the awaitables
+    void await(cThread *thread, cmplToken token, std::coroutine_handle<> handle) {
+        waiting.push_back({ .thread = thread, .token = token, .handle = handle });
+    }
+
+    /**
+     * @brief Runs all the spawned coroutines to completion
+     * @throws The first exception thrown from a spawned coroutine, if any; re-thrown once all coroutines have completed
+     */
+    void run() {
+        cExecutor *prev = std::exchange(curr, this);
+
+        while (!ready.empty() || !waiting.empty()) {
+            // Resume all the coroutines which can proceed; they may add themselves to the waiting list again
+            while (!ready.empty()) {
+                std::coroutine_handle<> handle = ready.front();
+                ready.pop_front();
+                handle.resume();
+            }
+
+            // Poll the outstanding operations and mark the coroutines of completed ones as ready
+            size_t n_remaining = 0;
+            for (size_t i = 0; i < waiting.size(); i++) {
+                if (waiting[i].thread->isCompleted(waiting[i].token)) {
+                    ready.push_back(waiting[i].handle);
+                } else {
+                    waiting[n_remaining++] = waiting[i];
+                }
+            }
+            waiting.resize(n_remaining);
+
+            if (ready.empty() && !waiting.empty()) {
+                cpuRelax();
+            }
+        }
+
+        curr = prev;
+
+        // All coroutines are completed; release them and propagate the first error
+        std::exception_ptr exc = nullptr;
+        for (auto &task : tasks) {
+            if (!exc && task.handle.promise().exc) {
+                exc = task.handle.promise().exc;
+            }
+        }
+        tasks.clear();
+
+        if (exc) {
+            std::rethrow_exception(exc);
+        }
+    }
+};
+
+/**
+ * @brief Awaitable for an already invoked Coyote operation
+ *
+ * Completes immediately if the operation is already done; otherwise, suspends the awaiting 
+ * coroutine on the current cExecutor until the operation's completion token is completed.
+ */
+class cCmplAwaitable {
+
+private:
+    cThread *thread;
+    cmplToken token;
+
+public:
+    cCmplAwaitable(cThread *thread, cmplToken token) : thread(thread), token(token) {}
+
+    bool await_ready() { return thread->isCompleted(token); }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        cExecutor *executor = cExecutor::current();
+        if (!executor) {
+            throw std::runtime_error("ERROR: Coyote operation awaited outside of a cExecutor, exiting...");
+        }
+        executor->await(thread, token, handle);
+    }
+
+    void await_resume() const {}
+
+    /// Returns the completion token of the awaited operation
+    cmplToken getToken() const { return token; }
+};
+
+/**
+ * @brief Awaits the completion of an already invoked Coyote operation
+ * @param thread cThread that invoked the operation
+ * @param token Token, as returned by cThread::invoke (with last = true)
+ */
+inline cCmplAwaitable completion(cThread &thread, cmplToken token) {
+    return cCmplAwaitable(&thread, token);
+}
+
+/**
+ * @brief Invokes a LOCAL_TRANSFER and awaits its completion, e.g. co_await coyote::transfer(thread, src_sg, dst_sg)
+ * @note The operation is invoked when this function is called, not when it's awaited
+ */
+inline cCmplAwaitable transfer(cThread &thread, localSg src_sg, localSg dst_sg) {
+    return cCmplAwaitable(&thread, thread.invoke(CoyoteOper::LOCAL_TRANSFER, src_sg, dst_sg, true));
+}
+
+/// Invokes a LOCAL_READ and awaits its completion
+inline cCmplAwaitable localRead(cThread &thread, localSg sg) {
+    return cCmplAwaitable(&thread, thread.invoke(CoyoteOper::LOCAL_READ, sg, true));
+}
+
+/// Invokes a LOCAL_WRITE and awaits its completion
+inline cCmplAwaitable localWrite(cThread &thread, localSg sg) {
+    return cCmplAwaitable(&thread, thread.invoke(CoyoteOper::LOCAL_WRITE, sg, true));
+}
+
+/// Invokes a REMOTE_RDMA_WRITE and awaits its completion
+inline cCmplAwaitable rdmaWrite(cThread &thread, rdmaSg sg) {
+    return cCmplAwaitable(&thread, thread.invoke(CoyoteOper::REMOTE_RDMA_WRITE, sg, true));
+}
+
+/// Invokes a REMOTE_RDMA_READ and awaits its completion
+inline cCmplAwaitable rdmaRead(cThread &thread, rdmaSg sg) {
+    return cCmplAwaitable(&thread, thread.invoke(CoyoteOper::REMOTE_RDMA_READ, sg, true));
+}
+
+}
+
+#endif // __cplusplus >= 202002L
+
+#endif // _COYOTE_CCORO_HPP_
@@ -28,6 +28,7 @@
 #define _COYOTE_CDEFS_HPP_
 
 #include <chrono> 
+#include <thread>
 #include <cstring> 
 #include <cstdint>
 #include <iomanip>
@@ -35,6 +36,10 @@
 #include <iostream>  
 #include <sys/ioctl.h> 
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 using namespace std::chrono_literals;
 
 namespace coyote {
@@ -239,6 +244,16 @@ constexpr unsigned long const MAX_TRANSFER_SIZE = 128 * 1024 * 1024;
 // Sleep time in nanoseconds for buszy wait loops; used while waiting for hardware to complete
 constexpr long const SLEEP_TIME = 100L;
 
+// Default time in nanoseconds spent spinning on the completion counters in waitCompleted, before blocking
+constexpr long const WAIT_SPIN_TIME = 20000L;
+
+// Minimum and maximum time in nanoseconds blocked in waitCompleted between two checks of the completion counters
+constexpr long const WAIT_MIN_SLEEP_TIME = 10000L;
+constexpr long const WAIT_MAX_SLEEP_TIME = 1000000L;
+
+// Maximum number of consecutive pause instructions between two polls of the command FIFO (CoyoteBackoff::SPIN_YIELD), before yielding the CPU
+constexpr uint32_t const BACKOFF_MAX_PAUSES = 64;
+
 // Maximum number of user interrupts to process simultaneously
 constexpr int const MAX_EVENTS = 1;
 
@@ -248,6 +263,10 @@ constexpr unsigned long long const HUGE_PAGE_SIZE = (2ULL * 1024ULL * 1024ULL);
 constexpr unsigned long const PAGE_SHIFT = 12UL;
 constexpr unsigned long const HUGE_PAGE_SHIFT = 21UL;
 
+// NUMA placement of memory allocated with getMem (see CoyoteAlloc::numa_node): on the node of the vFPGA's device (if known), or anywhere
+constexpr int32_t const NUMA_NODE_DEVICE = -1;
+constexpr int32_t const NUMA_NODE_ANY = -2;
+
 // Maximum number of Coyote threads per vFPGA
 constexpr int const N_CTID_MAX = 64;
 
@@ -463,6 +482,15 @@ public:
     #define htols(x)                          __bswap_16(x)
 #endif
 
+/// Hints to the CPU that the caller is in a busy-wait loop (e.g., polling a register); cheaper than yielding or sleeping
+inline void cpuRelax() {
+    #if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+    #else
+    std::this_thread::yield();
+    #endif
+}
+
 }
 
 #endif // _COYOTE_CDEFS_HPP_
\ No newline at end of file
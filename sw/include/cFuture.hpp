@@ -0,0 +1,150 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CFUTURE_HPP_
+#define _COYOTE_CFUTURE_HPP_
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+
+namespace coyote {
+
+/**
+ * @brief State shared between a cPromise and its cFuture(s)
+ *
+ * Holds whether the operation is completed, a (possible) error and the continuations
+ * to be executed once the operation completes. All accesses are protected by the mutex.
+ */
+struct cFutureState {
+    /// Protects all the fields below
+    std::mutex mtx;
+
+    /// Notified once the state becomes ready
+    std::condition_variable cv;
+
+    /// Set to true once the operation has completed (successfully or not)
+    bool ready = { false };
+
+    /// Error, if the operation failed; re-thrown by cFuture::wait()
+    std::exception_ptr exc = { nullptr };
+
+    /// Continuations, executed by the thread completing the state
+    std::vector<std::function<void()>> callbacks;
+
+    /// Token of the operation, if any
+    cmplToken token = { CMPL_TOKEN_NONE };
+};
+
+class cPromise;
+
+/**
+ * @brief A handle to the result of an asynchronous Coyote operation (e.g., cThread::invokeAsync)
+ *
+ * Similar to std::future, but it can be copied (all copies refer to the same operation) and it supports 
+ * continuations, which are executed as soon as the operation completes, on the thread that completes it.
+ * For operations invoked with invokeAsync, this is the shared completion thread, see cReactor.
+ */
+class cFuture {
+
+private:
+    std::shared_ptr<cFutureState> state;
+
+    friend class cPromise;
+
+public:
+    /// Default constructor; creates an invalid future, which isn't tied to any operation
+    cFuture() = default;
+
+    /// Creates a future for the given shared state
+    explicit cFuture(std::shared_ptr<cFutureState> state);
+
+    /// Returns true if the future is tied to an operation (i.e., it was obtained from a cPromise)
+    bool valid() const;
+
+    /// Returns true if the operation has completed (successfully or not); doesn't block
+    bool ready() const;
+
+    /**
+     * @brief Blocks until the operation has completed
+     * @throws The error the operation completed with, if any
+     */
+    void wait() const;
+
+    /**
+     * @brief Blocks until the operation has completed or the timeout expires
+     * @param timeout Maximum time to wait; e.g., std::chrono::microseconds(10)
+     * @return true if the operation has completed, false if the timeout expired
+     */
+    bool wait_for(std::chrono::nanoseconds timeout) const;
+
+    /**
+     * @brief Chains a continuation, which is executed once this operation completes
+     *
+     * If the operation is already completed, the continuation is executed immediately, by the calling thread.
+     * If the operation fails, the continuation isn't executed and the error is passed on to the returned future.
+     *
+     * @param func Continuation to be executed; should be short, since it blocks the completing thread
+     * @return Future, which is completed once the continuation has been executed
+     */
+    cFuture then(std::function<void()> func) const;
+
+    /// Returns the completion token of the operation, or CMPL_TOKEN_NONE if the operation isn't tracked by a token
+    cmplToken getToken() const;
+};
+
+/**
+ * @brief The producer side of a cFuture; used to complete the operation
+ */
+class cPromise {
+
+private:
+    std::shared_ptr<cFutureState> state;
+
+public:
+    /// Creates a new, not yet completed, operation with the given token
+    cPromise(cmplToken token = CMPL_TOKEN_NONE);
+
+    /// Returns a future for this operation; can be called multiple times
+    cFuture getFuture() const;
+
+    /// Marks the operation as successfully completed, wakes up all waiting threads and executes the continuations
+    void setReady() const;
+
+    /// Same as setReady(), but the operation has failed with the given error
+    void setException(std::exception_ptr exc) const;
+};
+
+}
+
+#endif // _COYOTE_CFUTURE_HPP_
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CHISTOGRAM_HPP_
+#define _COYOTE_CHISTOGRAM_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "cDefs.hpp"
+
+namespace coyote {
+
+/// Default precision of a cHistogram, in significant bits; the relative error of the recorded values is below 2^-(precision - 1)
+constexpr uint32_t const HIST_DEFAULT_PRECISION = 8;
+
+/// Maximum precision of a cHistogram, in significant bits
+constexpr uint32_t const HIST_MAX_PRECISION = 16;
+
+/**
+ * @brief Log/linear bucketed histogram, in the style of HdrHistogram
+ *
+ * Values below 2^precision are counted exactly; above that, every power-of-two range is split into 2^(precision - 1) 
+ * equally wide buckets, so the relative error of any value is below 2^-(precision - 1) (e.g., below 0.8% for the default
+ * precision of 8 bits). The entire 64-bit range is covered with a constant amount of memory (about 58 KB for the default 
+ * precision), regardless of the number of recorded values. Additionally, the minimum, maximum, mean and variance are 
+ * tracked exactly (the latter two with Welford's algorithm).
+ *
+ * Histograms with the same precision can be merged, e.g., to aggregate the latencies recorded by multiple threads; 
+ * they can also be serialized to a compact string, for aggregating the results of multiple processes.
+ */
+class cHistogram {
+
+private:
+    /// Number of significant bits
+    uint32_t precision;
+
+    /// Number of recorded values per bucket
+    std::vector<uint64_t> counts;
+
+    /// Total number of recorded values, their minimum and maximum
+    uint64_t count = { 0 };
+    uint64_t min_value = { UINT64_MAX };
+    uint64_t max_value = { 0 };
+
+    /// Running mean and sum of squared differences from the mean (Welford's algorithm)
+    double mean = { 0 };
+    double m2 = { 0 };
+
+    /// Utility function, returning the index of the bucket for a value
+    uint32_t getBucket(uint64_t value) const;
+
+    /// Utility function, returning the range of values [lo, hi] counted by a bucket
+    void getBucketRange(uint32_t bucket, uint64_t &lo, uint64_t &hi) const;
+
+public:
+    /**
+     * @brief Default constructor
+     * @param precision Number of significant bits, between 1 and HIST_MAX_PRECISION (default: HIST_DEFAULT_PRECISION)
+     */
+    cHistogram(uint32_t precision = HIST_DEFAULT_PRECISION);
+
+    /**
+     * @brief Records a value
+     * @param value Value to be recorded (e.g., a latency in ns)
+     * @param n Number of times the value is recorded (default: 1)
+     */
+    void record(uint64_t value, uint64_t n = 1);
+
+    /**
+     * @brief Adds all the values of another histogram to this histogram
+     * @param other Histogram to be merged; must have the same precision
+     */
+    void merge(const cHistogram &other);
+
+    /// Removes all the recorded values
+    void clear();
+
+    /// Getter: Precision, in significant bits
+    uint32_t getPrecision() const;
+
+    /// Getter: Number of recorded values
+    uint64_t getCount() const;
+
+    /// Getter: Minimum recorded value; NaN if the histogram is empty
+    double getMin() const;
+
+    /// Getter: Maximum recorded value; NaN if the histogram is empty
+    double getMax() const;
+
+    /// Getter: Mean of the recorded values; NaN if the histogram is empty
+    double getMean() const;
+
+    /// Getter: Sample standard deviation of the recorded values; NaN if fewer than two values were recorded
+    double getStdDev() const;
+
+    /**
+     * @brief Returns a percentile of the recorded values
+     *
+     * The result is the middle of the bucket, which holds the smallest value that is greater than or equal to 
+     * the given percentage of all the recorded values, clamped to the recorded minimum and maximum
+     *
+     * @param percentile Percentile, between 0 and 100 (e.g., 99.99)
+     * @return Value at the percentile; NaN if the histogram is empty
+     */
+    double getPercentile(double percentile) const;
+
+    /**
+     * @brief Serializes the histogram to a string
+     *
+     * The string is a single line, holding the precision, the exact statistics and only the non-empty buckets,
+     * so it stays small even for histograms with many recorded values
+     */
+    std::string serialize() const;
+
+    /**
+     * @brief Restores a histogram from a string, as returned by serialize()
+     * @param str Serialized histogram
+     * @return Deserialized histogram
+     */
+    static cHistogram deserialize(const std::string &str);
+};
+
+}
+
+#endif // _COYOTE_CHISTOGRAM_HPP_
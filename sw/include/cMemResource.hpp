@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CMEMRESOURCE_HPP_
+#define _COYOTE_CMEMRESOURCE_HPP_
+
+#include <memory_resource>
+
+#include "cBufferPool.hpp"
+
+namespace coyote {
+
+/**
+ * @brief Polymorphic memory resource (std::pmr::memory_resource), allocating memory that is mapped to a vFPGA
+ *
+ * The resource allocates from its own cBufferPool, which reserves memory with cThread::getMem (HPF or THP) and keeps 
+ * track of all the mappings. Therefore, standard containers using the resource (e.g., std::pmr::vector) can be passed 
+ * directly to invoke, by pointing a localSg at their data(), without any staging copies:
+ *
+ * @code
+ * coyote::cMemResource resource(coyote_thread);
+ * std::pmr::vector<float> data(n, &resource);
+ * coyote_thread.invoke(coyote::CoyoteOper::LOCAL_READ, {.addr = data.data(), .len = n * sizeof(float)});
+ * @endcode
+ *
+ * Small and over-aligned allocations are served from the pooled slabs (64 B - 2 MB, aligned to their size), 
+ * so many small containers share the same huge pages; larger allocations are passed through to cThread::getMem.
+ *
+ * @note The cThread must outlive the resource and the resource must outlive all the containers using it.
+ */
+class cMemResource : public std::pmr::memory_resource {
+
+private:
+    /// Pool serving all the allocations
+    cBufferPool pool;
+
+protected:
+    /// Allocates a buffer of at least the given size and alignment; throws std::bad_alloc if the request can't be served
+    void* do_allocate(size_t bytes, size_t alignment) override;
+
+    /// Returns a buffer to the pool
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+
+    /// Two resources are only equal if they're the same object, since the memory is owned by the pool
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+public:
+    /**
+     * @brief Creates a new memory resource; memory is only reserved on demand
+     *
+     * @param thread cThread, used for mapping the memory to the vFPGA
+     * @param alloc_type Type of the memory; must be CoyoteAllocType::HPF or CoyoteAllocType::THP
+     * @param region_size Size of the regions reserved by the pool, see cBufferPool
+     */
+    cMemResource(cThread &thread, CoyoteAllocType alloc_type = CoyoteAllocType::HPF, uint32_t region_size = BPOOL_REGION_SIZE);
+
+    /// Returns true if the pointer points to memory allocated from this resource
+    bool owns(const void *ptr) { return pool.owns(ptr); }
+
+    /// Returns the underlying pool, e.g., to reserve memory upfront or to obtain its statistics
+    cBufferPool& getPool() { return pool; }
+};
+
+}
+
+#endif // _COYOTE_CMEMRESOURCE_HPP_
@@ -27,6 +27,8 @@
 #ifndef _COYOTE_COPS_HPP_
 #define _COYOTE_COPS_HPP_
 
+#include <vector>
+
 #include "cDefs.hpp"
 
 namespace coyote {
@@ -68,6 +70,9 @@ enum class CoyoteOper {
     REMOTE_TCP_SEND = 9  
 };
 
+/// Number of Coyote operations; all CoyoteOper values are smaller than this (e.g., for per-operation statistics)
+constexpr uint32_t const N_COYOTE_OPERS = 10;
+
 /*
  * Various helper function to check the type of operation
  */
@@ -90,6 +95,83 @@ inline constexpr bool isRemoteWriteOrSend(CoyoteOper oper) { return oper == Coyo
 
 inline constexpr bool isRemoteTcp(CoyoteOper oper) { return oper == CoyoteOper::REMOTE_TCP_SEND; }
 
+///////////////////////////////////////////////////
+//            COYOTE COMMAND SUBMISSION         //
+//////////////////////////////////////////////////
+
+/// @brief Policies for waiting on space in the vFPGA command FIFO, once it's full (see cThread::setBackoff)
+enum class CoyoteBackoff {
+    /// Busy-poll the FIFO, with a single pause instruction between two polls; lowest latency, but occupies the CPU core
+    SPIN = 0,
+
+    /// Busy-poll the FIFO with exponentially increasing pauses between two polls (up to BACKOFF_MAX_PAUSES), then yield the CPU
+    SPIN_YIELD = 1,
+
+    /// Sleep for SLEEP_TIME nanoseconds between two polls; in practice, the sleep is much longer due to the timer and scheduler overhead
+    SLEEP = 2
+};
+
+/// @brief Statistics on the stalls in command submission, caused by a full command FIFO in the vFPGA
+struct cmdStallStats {
+    /// Number of times a command couldn't be posted because the FIFO was full
+    uint64_t n_stalls = { 0 };
+
+    /// Number of reads of the outstanding commands from the vFPGA (uncached MMIO reads of CTRL_REG)
+    uint64_t n_polls = { 0 };
+
+    /// Total time spent waiting on the FIFO, in nanoseconds
+    uint64_t stall_ns = { 0 };
+
+    /// Longest single wait on the FIFO, in nanoseconds
+    uint64_t max_stall_ns = { 0 };
+};
+
+/// @brief Statistics on blocking waits for completions (see cThread::waitCompleted)
+struct cmplWaitStats {
+    /// Number of calls to waitCompleted
+    uint64_t n_waits = { 0 };
+
+    /// Number of waits that fell back to sleeping, since the operations didn't complete within the spin budget
+    uint64_t n_sleeps = { 0 };
+
+    /// Number of times a sleeping wait was woken up by a user interrupt, rather than its timer
+    uint64_t n_irq_wakeups = { 0 };
+
+    /// Number of waits that timed out
+    uint64_t n_timeouts = { 0 };
+
+    /// Total time spent sleeping, in nanoseconds
+    uint64_t sleep_ns = { 0 };
+
+    /** 
+     * Total and maximum duration of the final sleep of the successful sleeping waits, in nanoseconds; DMA completions 
+     * don't raise an interrupt, so the exact wakeup latency isn't observable, but it's bounded by the final sleep
+     */
+    uint64_t final_sleep_ns = { 0 };
+    uint64_t max_final_sleep_ns = { 0 };
+};
+
+/**
+ * @brief Token identifying a single invoked operation, as returned by cThread::invoke
+ *
+ * The upper bits encode the completion class of the operation (local read, local write, RDMA read, RDMA write),
+ * and the lower bits encode a per-class sequence number, which is compared against the completion counters.
+ * Operations that complete synchronously (or aren't tracked by the hardware) return CMPL_TOKEN_NONE.
+ */
+typedef uint64_t cmplToken;
+
+/// Token for operations without completion tracking; always considered completed
+constexpr cmplToken const CMPL_TOKEN_NONE = 0;
+
+/// @brief A completed operation, as returned by cThread::pollCompletions
+struct cmplEntry {
+    /// Token returned by cThread::invoke when the operation was issued
+    cmplToken token = { CMPL_TOKEN_NONE };
+
+    /// Operation type
+    CoyoteOper oper = { CoyoteOper::NOOP };
+};
+
 ///////////////////////////////////////////////////
 //                 COYOTE MEMORY                //
 //////////////////////////////////////////////////
@@ -131,6 +213,12 @@ struct CoyoteAlloc {
 
     /// Pointer to the allocated memory; the struct keeps track of it so that it can be freed automatically after use
     void *mem = { nullptr };
+
+    /** 
+     * NUMA node of the memory (REG, THP and HPF); by default, the memory is placed on the node of the vFPGA's device, 
+     * if possible. A node ID (>= 0) binds the memory strictly to that node, while NUMA_NODE_ANY leaves the placement to the kernel
+     */
+    int32_t numa_node = { NUMA_NODE_DEVICE };
 };
 
 ///////////////////////////////////////////////////
@@ -157,7 +245,7 @@ struct localSg {
     void* addr = { nullptr };
 
     /// Buffer length in bytes
-    uint32_t len = { 0 };
+    uint64_t len = { 0 };
 
     /// Buffer stream: HOST or CARD
     uint32_t stream = { STRM_HOST };
@@ -166,6 +254,9 @@ struct localSg {
     uint32_t dest = { 0 };
 };
 
+/// @brief List of scatter-gather entries for local operations on non-contiguous buffers, which are streamed as one logical packet
+typedef std::vector<localSg> sgList;
+
 /** 
  * @brief Scatter-gather entry for RDMA operations (REMOTE_READ, REMOTE_WRITE)
  * NOTE: No field for source/dest address, since these are defined when exchanging queue pair information
@@ -188,7 +279,7 @@ struct rdmaSg {
     uint32_t remote_dest = { 0 };
 
     /// Lenght of the RDMA transfer, in bytes
-    uint32_t len = { 0 };
+    uint64_t len = { 0 };
 };
 
 /// @brief Scatter-gather entry for TCP operations (REMOTE_TCP_SEND)
@@ -196,7 +287,25 @@ struct tcpSg {
     // Session
     uint32_t stream = { STRM_TCP };
     uint32_t dest = { 0 };
-    uint32_t len = { 0 };
+    uint64_t len = { 0 };
+};
+
+/**
+ * @brief A single DMA command, as written to the vFPGA config registers (see cThread::postCmd)
+ * NOTE: The order of the fields matches the order of the 64-bit words in the AVX CTRL_REG
+ */
+struct cmdDesc {
+    /// Destination address
+    uint64_t addr_dst = { 0 };
+
+    /// Destination control signals (e.g., size, offset, stream etc.)
+    uint64_t ctrl_dst = { 0 };
+
+    /// Source address
+    uint64_t addr_src = { 0 };
+
+    /// Source control signals (e.g., size, offset, stream etc.)
+    uint64_t ctrl_src = { 0 };
 };
 
 
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CPERF_HPP_
+#define _COYOTE_CPERF_HPP_
+
+#include <array>
+#include <string>
+#include <cstdint>
+
+namespace coyote {
+
+/// Hardware and software events, which can be counted with cPerf
+enum class cPerfEvent : uint32_t {
+    /// CPU cycles, in user space
+    CYCLES = 0,
+
+    /// Retired instructions, in user space
+    INSTRUCTIONS = 1,
+
+    /// Last-level cache misses (read accesses), in user space; e.g., polling a completion counter written by the vFPGA
+    LLC_MISSES = 2,
+
+    /// Data TLB misses (read accesses), in user space; e.g., buffers that aren't backed by hugepages
+    DTLB_MISSES = 3,
+
+    /// Context switches of the thread; requires counting kernel events, i.e., perf_event_paranoid of at most 1 (or CAP_PERFMON)
+    CONTEXT_SWITCHES = 4
+};
+
+/// Number of events in cPerfEvent
+constexpr uint32_t const N_PERF_EVENTS = 5;
+
+/// Returns the name of an event, e.g., for printing
+const char* getPerfEventName(cPerfEvent event);
+
+/// Event counts, as read by cPerf
+struct cPerfCounts {
+    /// Count of every event, indexed by cPerfEvent; scaled up if the counter was multiplexed with other events
+    std::array<double, N_PERF_EVENTS> values = {};
+
+    /// Whether every event could be counted; the counts of unavailable events are always 0
+    std::array<bool, N_PERF_EVENTS> available = {};
+
+    /// Returns the count of an event
+    double get(cPerfEvent event) const { return values[static_cast<uint32_t>(event)]; }
+
+    /// Returns true if the event could be counted
+    bool isAvailable(cPerfEvent event) const { return available[static_cast<uint32_t>(event)]; }
+
+    /// Adds the counts of another measurement, e.g., of another thread
+    cPerfCounts& operator+=(const cPerfCounts &other);
+};
+
+/**
+ * @brief Hardware performance counters of the calling thread, opened with perf_event_open
+ *
+ * The counters only count the events of the thread that created the cPerf object, and only while they are enabled;
+ * so, they can be enabled around the code of interest, e.g., every run of a benchmark (see cBench::setPerfCounters).
+ * Unprivileged users can count the events, as long as perf_event_paranoid allows it: the hardware events are only 
+ * counted in user space (which is allowed up to perf_event_paranoid = 2), while context switches happen in the kernel
+ * and require perf_event_paranoid <= 1. Events, which can't be counted (due to the permissions or since the CPU 
+ * doesn't support them, e.g., in a VM), are reported as unavailable, with a warning, rather than failing.
+ *
+ * @note Enabling and disabling the counters takes one system call per event, so it should be done outside of any timed region
+ */
+class cPerf {
+
+private:
+    /// File descriptors of the counters, indexed by cPerfEvent; -1 if the event is unavailable
+    std::array<int, N_PERF_EVENTS> fds;
+
+public:
+    /// Default constructor; opens the counters of the calling thread, which are initially disabled
+    cPerf();
+
+    /// Destructor; closes the counters
+    ~cPerf();
+
+    cPerf(const cPerf&) = delete;
+    cPerf& operator=(const cPerf&) = delete;
+
+    /// Returns true if the event can be counted
+    bool isAvailable(cPerfEvent event) const;
+
+    /// Starts (or resumes) counting
+    void enable();
+
+    /// Stops counting; the counts are kept until reset()
+    void disable();
+
+    /// Sets all the counts to zero
+    void reset();
+
+    /// Returns the counts of all the events, since the last reset
+    cPerfCounts read() const;
+
+    /// Returns the value of perf_event_paranoid, or INT32_MAX if it can't be read (e.g., the kernel doesn't support perf events)
+    static int32_t getParanoidLevel();
+};
+
+}
+
+#endif // _COYOTE_CPERF_HPP_
@@ -0,0 +1,153 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CREACTOR_HPP_
+#define _COYOTE_CREACTOR_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+#include "cFuture.hpp"
+
+namespace coyote {
+
+class cThread;
+
+/// Maximum number of pause instructions between two sweeps of the reactor, when the previous sweeps found no completed operations
+constexpr uint32_t const REACTOR_MAX_BACKOFF = 256;
+
+/**
+ * @brief Process-wide completion thread for asynchronous Coyote operations
+ *
+ * Instead of every application thread spinning on checkCompleted() for its own cThread,
+ * a single reactor thread polls the completion counters (writeback regions) of all the
+ * registered operations, across all cThreads in the process, in a tight loop. Once an operation
+ * completes, its cFuture is completed, waking up the waiting threads and executing its continuations.
+ * The reactor thread is started on the first registered operation and sleeps whenever there are none.
+ *
+ * New operations are handed to the reactor through a short-held inbox, which the reactor splices into its own list
+ * of operations; this list is polled without any locks, so issuing threads never wait for a sweep over the counters.
+ *
+ * @note Only the (read-only) completion counters of a cThread are accessed from the reactor thread;
+ * therefore, the cThreads can keep on issuing new operations concurrently.
+ */
+class cReactor {
+
+private:
+    /// A registered, not yet completed, operation
+    struct cWatch {
+        /// cThread that issued the operation
+        const cThread *thread;
+
+        /// Operation, whose counter is polled (see cThread::checkCompleted)
+        CoyoteOper oper;
+
+        /// Token of the operation
+        cmplToken token;
+
+        /// Completed once the operation is completed
+        cPromise promise;
+    };
+
+    /// Protects the fields below, up to the reactor thread; only held for handing over operations and removals
+    std::mutex mtx;
+
+    /// Notified when there are new operations or removals, or the reactor is being stopped
+    std::condition_variable cv;
+
+    /// Newly registered operations, not yet taken over by the reactor thread
+    std::vector<cWatch> inbox;
+
+    /// cThreads, whose operations should be removed by the reactor thread (see removeThread)
+    std::vector<const cThread*> removals;
+
+    /// Number of removals requested and completed by the reactor thread; removeThread waits until its removal completed
+    uint64_t n_removals_requested = { 0 };
+    uint64_t n_removals_done = { 0 };
+    std::condition_variable removals_cv;
+
+    /// Set to true to terminate the reactor thread
+    bool stop = { false };
+
+    /// Set whenever the inbox or the removals are non-empty, so that the reactor only takes the lock when there's something to take over
+    std::atomic<bool> pending = { false };
+
+    /// Number of operations currently tracked, including those in the inbox
+    std::atomic<size_t> n_watches = { 0 };
+
+    /// Registered operations, polled in order of registration; only accessed by the reactor thread
+    std::vector<cWatch> watches;
+
+    /// Thread polling the completions
+    std::thread reactor_thread;
+
+    cReactor() = default;
+
+    /// Main loop of the reactor thread
+    void run();
+
+    /// Removes the operations of a cThread from the given list, collecting their promises; returns the number of removed operations
+    static size_t removeWatches(std::vector<cWatch> &list, const cThread *thread, std::vector<cPromise> &removed);
+
+public:
+    /// Stops the reactor thread; any operations still registered are never completed
+    ~cReactor();
+
+    cReactor(const cReactor&) = delete;
+    cReactor& operator=(const cReactor&) = delete;
+
+    /// Returns the process-wide reactor
+    static cReactor& getInstance();
+
+    /**
+     * @brief Registers an issued operation, whose completion should be tracked by the reactor
+     * 
+     * @param thread cThread that issued the operation
+     * @param token Token of the operation, as returned by cThread::invoke; must have been issued with last = true
+     * @return Future, which is completed once the operation is completed; ready immediately for CMPL_TOKEN_NONE
+     */
+    cFuture watch(const cThread *thread, cmplToken token);
+
+    /**
+     * @brief Removes all the operations of a cThread; called when the cThread is destroyed
+     * 
+     * The futures of removed operations are completed with an error. Once this function returns,
+     * the reactor thread no longer accesses the cThread.
+     */
+    void removeThread(const cThread *thread);
+
+    /// Returns the number of operations currently tracked by the reactor
+    size_t getNumWatches();
+};
+
+}
+
+#endif // _COYOTE_CREACTOR_HPP_
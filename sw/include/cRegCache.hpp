@@ -0,0 +1,199 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CREGCACHE_HPP_
+#define _COYOTE_CREGCACHE_HPP_
+
+#include <map>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <functional>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+
+namespace coyote {
+
+/// Default budget of the registration cache, i.e., the maximum memory it keeps pinned (1 GB)
+constexpr uint64_t const REG_CACHE_BUDGET = 1024ULL * 1024ULL * 1024ULL;
+
+/// Maximum length of a single registration in the driver; longer ranges are registered in multiple parts (1 GB)
+constexpr uint32_t const REG_CACHE_MAX_MAP = 1024 * 1024 * 1024;
+
+/// @brief Statistics of a cRegCache
+struct cRegCacheStats {
+    /// Number of lookups for which the entire range was already registered
+    uint64_t n_hits = { 0 };
+
+    /// Number of lookups for which (parts of) the range had to be registered
+    uint64_t n_misses = { 0 };
+
+    /// Number of registrations (userMap calls) issued by the cache
+    uint64_t n_maps = { 0 };
+
+    /// Number of entries evicted to stay within the budget
+    uint64_t n_evictions = { 0 };
+
+    /// Memory currently pinned by the cache, in bytes; excludes memory registered by the user (getMem, userMap)
+    uint64_t pinned_bytes = { 0 };
+
+    /// Number of entries currently in the cache, including the ones registered by the user
+    uint64_t n_entries = { 0 };
+};
+
+/**
+ * @brief Registration cache for user buffers, similar to a memory region (MR) cache in RDMA libraries
+ *
+ * Every registration (cThread::userMap) is an ioctl, which pins the pages in the driver; therefore, 
+ * buffers that weren't allocated with cThread::getMem should only be registered once and re-used.
+ * The cache keeps an interval map of all the registered ranges, at page granularity. Ranges registered 
+ * by the user (getMem, userMap) are tracked, but never evicted. When a range is acquired, only the parts 
+ * not covered by existing entries are registered and the new registrations are merged with adjacent 
+ * cache entries, so that repeated lookups of the same range resolve to a single entry.
+ * 
+ * Entries registered by the cache are kept in LRU order; once the pinned memory exceeds the budget, 
+ * the least recently used entries are unregistered.
+ *
+ * @note The cache can't observe when user memory is freed and re-allocated. Buffers that are freed while registered
+ * must be invalidated (cThread::invalidateRegCache) before the memory is re-used; otherwise, the vFPGA would access stale pages.
+ * Similarly, the budget should be larger than the memory used by all the in-flight operations, since an evicted
+ * range is unregistered immediately.
+ */
+class cRegCache {
+
+private:
+    /// An entry of the cache, i.e., a range of contiguous, registered, pages
+    struct cRegEntry {
+        /// End of the range (exclusive); the start is the key in the interval map
+        uint64_t end = { 0 };
+
+        /// Set to true if the range was registered by the user; such entries are never evicted
+        bool user = { false };
+
+        /// Registrations in the driver (start address, length) making up the range; merged entries have multiple
+        std::vector<std::pair<uint64_t, uint32_t>> maps;
+
+        /// Position in the LRU list; only valid for entries registered by the cache
+        std::list<uint64_t>::iterator lru;
+    };
+
+    /// Registers a range in the driver (cThread::userMap)
+    std::function<void(void*, uint32_t)> map_fn;
+
+    /// Unregisters a range in the driver (cThread::userUnmap)
+    std::function<void(void*)> unmap_fn;
+
+    /// Set to true if ranges are registered on lookup
+    std::atomic<bool> enabled = { false };
+
+    /// Maximum memory pinned by the cache
+    uint64_t budget = { REG_CACHE_BUDGET };
+
+    /// Interval map of the entries, keyed by the start address; the entries never overlap
+    std::map<uint64_t, cRegEntry> entries;
+
+    /// Start addresses of the entries registered by the cache, most recently used first
+    std::list<uint64_t> lru_list;
+
+    /// Statistics
+    cRegCacheStats stats;
+
+    /// Protects all the fields above
+    std::mutex mtx;
+
+    /// Returns the first entry which ends after the given address
+    std::map<uint64_t, cRegEntry>::iterator findFirst(uint64_t addr);
+
+    /// Marks an entry as the most recently used one
+    void touch(std::map<uint64_t, cRegEntry>::iterator it);
+
+    /// Unregisters an entry, registered by the cache, and removes it from the cache
+    std::map<uint64_t, cRegEntry>::iterator evict(std::map<uint64_t, cRegEntry>::iterator it);
+
+    /// Merges all the adjacent cache entries in [start, end) into a single entry
+    void merge(uint64_t start, uint64_t end);
+
+    /// Evicts the least recently used entries until the pinned memory is within the budget; entries overlapping [start, end) are kept
+    void shrink(uint64_t start, uint64_t end);
+
+public:
+    /**
+     * @brief Creates a new, disabled, registration cache
+     *
+     * @param map_fn Function registering a range in the driver
+     * @param unmap_fn Function unregistering a range in the driver, given its start address
+     */
+    cRegCache(std::function<void(void*, uint32_t)> map_fn, std::function<void(void*)> unmap_fn);
+
+    cRegCache(const cRegCache&) = delete;
+    cRegCache& operator=(const cRegCache&) = delete;
+
+    /**
+     * @brief Enables or disables the cache; disabling the cache unregisters all the ranges registered by it
+     *
+     * @param enable If true, unregistered ranges are registered on lookup (acquire)
+     * @param budget Maximum memory kept pinned by the cache, in bytes
+     */
+    void setEnabled(bool enable, uint64_t budget = REG_CACHE_BUDGET);
+
+    /// Returns true if the cache is enabled
+    bool isEnabled() const { return enabled.load(); }
+
+    /**
+     * @brief Ensures a range is registered, registering (only) the parts that aren't already; no-op if the cache is disabled
+     *
+     * @param addr Start of the range
+     * @param len Length of the range, in bytes
+     */
+    void acquire(const void *addr, uint64_t len);
+
+    /// Ensures the buffers of the host-memory scatter-gather entries are registered; no-op if the cache is disabled
+    void acquire(const localSg *sgs, size_t n_sgs);
+
+    /**
+     * @brief Tracks a range registered by the user, so that it's not registered again; the range is never evicted
+     * @note Any cache entries overlapping the range must be invalidated before the range is registered by the user
+     */
+    void insertUser(void *vaddr, uint32_t len);
+
+    /// Stops tracking a range registered by the user, given the address it was registered with
+    void removeUser(void *vaddr);
+
+    /// Unregisters all the cache entries overlapping the given range, e.g., because the memory is about to be freed
+    void invalidate(const void *addr, uint64_t len);
+
+    /// Unregisters all the cache entries and stops tracking the ranges registered by the user
+    void clear();
+
+    /// Returns the statistics of the cache
+    cRegCacheStats getStats();
+};
+
+}
+
+#endif // _COYOTE_CREGCACHE_HPP_
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CSTATS_HPP_
+#define _COYOTE_CSTATS_HPP_
+
+#include <atomic>
+#include <string>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+#include "cRegCache.hpp"
+
+namespace coyote {
+
+/**
+ * @brief Snapshot of the host-side statistics of a cThread, as returned by cThread::getStats
+ *
+ * All counters are cumulative since the creation of the cThread. Together with the hardware counters 
+ * (see cThread::printDebug), they show whether time is spent on the host (submission, stalls, mappings) or in the vFPGA.
+ */
+struct cThreadStats {
+    /// vFPGA ID and Coyote thread ID of the cThread
+    int32_t vfid = { 0 };
+    int32_t ctid = { 0 };
+
+    /// Number of invoked operations, indexed by CoyoteOper
+    uint64_t n_ops[N_COYOTE_OPERS] = { 0 };
+
+    /// Number of DMA commands posted to the vFPGA, indexed by CoyoteOper; long transfers and scatter-gather lists are posted as many commands
+    uint64_t n_cmds[N_COYOTE_OPERS] = { 0 };
+
+    /// Number of bytes moved, indexed by CoyoteOper
+    uint64_t n_bytes[N_COYOTE_OPERS] = { 0 };
+
+    /// Number of control register writes and reads (setCSR, getCSR and their bulk variants count every register)
+    uint64_t n_csr_writes = { 0 };
+    uint64_t n_csr_reads = { 0 };
+
+    /// Number of page-mapping ioctls (mapping and unmapping buffers in the vFPGA's TLB)
+    uint64_t n_map_ioctls = { 0 };
+    uint64_t n_unmap_ioctls = { 0 };
+
+    /// Number of user interrupts handled
+    uint64_t n_irqs = { 0 };
+
+    /// Stalls in command submission, caused by a full command FIFO
+    cmdStallStats stall;
+
+    /// Blocking waits for completions
+    cmplWaitStats wait;
+
+    /// Registration cache
+    cRegCacheStats reg_cache;
+};
+
+/**
+ * @brief Live counters of a cThread, from which cThreadStats snapshots are taken
+ *
+ * The counters are updated on the hot path, so all updates are relaxed atomic operations; 
+ * they are safe to read from any thread, but a snapshot isn't necessarily consistent across counters.
+ */
+struct cThreadCounters {
+    std::atomic<uint64_t> n_ops[N_COYOTE_OPERS] = {};
+    std::atomic<uint64_t> n_cmds[N_COYOTE_OPERS] = {};
+    std::atomic<uint64_t> n_bytes[N_COYOTE_OPERS] = {};
+
+    std::atomic<uint64_t> n_csr_writes = { 0 }, n_csr_reads = { 0 };
+    std::atomic<uint64_t> n_map_ioctls = { 0 }, n_unmap_ioctls = { 0 };
+    std::atomic<uint64_t> n_irqs = { 0 };
+
+    std::atomic<uint64_t> n_stalls = { 0 }, n_polls = { 0 }, stall_ns = { 0 }, max_stall_ns = { 0 };
+
+    std::atomic<uint64_t> n_waits = { 0 }, n_sleeps = { 0 }, n_irq_wakeups = { 0 }, n_timeouts = { 0 };
+    std::atomic<uint64_t> sleep_ns = { 0 }, final_sleep_ns = { 0 }, max_final_sleep_ns = { 0 };
+
+    /// Fills the counters into a snapshot; the registration cache statistics aren't part of the counters
+    void snapshot(cThreadStats &stats) const;
+
+    /// Snapshot of the stall counters
+    cmdStallStats getStallStats() const;
+
+    /// Snapshot of the wait counters
+    cmplWaitStats getWaitStats() const;
+};
+
+/// Increments a counter; a relaxed atomic operation, since counters don't synchronize anything
+inline void statAdd(std::atomic<uint64_t> &cnt, uint64_t val = 1) {
+    cnt.fetch_add(val, std::memory_order_relaxed);
+}
+
+/// Raises a maximum to the given value, if it's larger
+inline void statMax(std::atomic<uint64_t> &cnt, uint64_t val) {
+    uint64_t cur = cnt.load(std::memory_order_relaxed);
+    while (val > cur && !cnt.compare_exchange_weak(cur, val, std::memory_order_relaxed)) {}
+}
+
+/// Returns the name of an operation, e.g., "LOCAL_READ"
+const char* getOperName(CoyoteOper oper);
+
+/**
+ * @brief Exports statistics as a JSON object
+ *
+ * Operations without any activity are omitted from the "opers" object. Example:
+ * {"vfid":0,"ctid":1,"opers":{"LOCAL_TRANSFER":{"ops":10,"cmds":10,"bytes":40960}},"csr":{"writes":4,"reads":1},...}
+ */
+std::string toJson(const cThreadStats &stats);
+
+/**
+ * @brief Exports statistics in the Prometheus text exposition format
+ *
+ * Every metric is prefixed with coyote_ and labelled with the vFPGA and Coyote thread IDs (and the operation, where applicable),
+ * so the output of many cThreads can be concatenated; the HELP and TYPE lines are only included if help is true.
+ */
+std::string toPrometheus(const cThreadStats &stats, bool help = true);
+
+}
+
+#endif // _COYOTE_CSTATS_HPP_
@@ -0,0 +1,191 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CSUBMITQUEUE_HPP_
+#define _COYOTE_CSUBMITQUEUE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <exception>
+
+#include "cDefs.hpp"
+
+namespace coyote {
+
+/// Number of slots in the submission queue; bounds the number of producers with outstanding requests before they have to wait
+constexpr uint32_t const SUBMIT_QUEUE_DEPTH = 256;
+
+/**
+ * @brief Multi-producer, single-consumer submission queue with a combining flusher
+ *
+ * Allows many application threads to submit operations through one cThread (and hence one ctid), without corrupting
+ * the commands or the completion tokens. Every submission consists of two steps:
+ *  - reserve: executed under a short spinlock, which assigns the request its position in the queue, 
+ *    together with anything else that must follow the same order (e.g., the completion token)
+ *  - post: executed later, in the order of the reservations, by a single flusher (e.g., writing the commands to the vFPGA)
+ *
+ * The requests are published in a lock-free ring. There is no dedicated flusher thread; instead, every producer 
+ * waiting for its request tries to become the flusher and, if successful, posts all the published requests of all 
+ * producers (flat combining). Therefore, the post steps never run concurrently and the hardware sees the commands 
+ * of every operation back-to-back, in the same order as the tokens were assigned.
+ *
+ * @note submit() returns once the request has been posted, so any state captured by the post step may live on the caller's stack
+ */
+class cSubmitQueue {
+
+private:
+    /// A request, owned by the submitting thread (on its stack) for the duration of submit()
+    struct cSubmitReq {
+        /// Executes the post step of the request
+        void (*run)(cSubmitReq*) = { nullptr };
+
+        /// Set by the flusher, once the post step was executed
+        std::atomic<bool> done = { false };
+
+        /// Exception thrown by the post step, if any; re-thrown by submit()
+        std::exception_ptr exc;
+    };
+
+    /// Request, with the post step of the caller
+    template <typename P>
+    struct cSubmitReqImpl : cSubmitReq {
+        P &post;
+
+        explicit cSubmitReqImpl(P &post) : post(post) {
+            run = [](cSubmitReq *req) { static_cast<cSubmitReqImpl*>(req)->post(); };
+        }
+    };
+
+    /// A slot in the ring
+    struct cSubmitSlot {
+        /// Position of the published request plus one; the slot is published once it matches the expected position
+        std::atomic<uint64_t> seq = { 0 };
+
+        /// Published request
+        cSubmitReq *req = { nullptr };
+    };
+
+    /// Ring of published requests
+    std::unique_ptr<cSubmitSlot[]> slots;
+
+    /// Reservation lock, protecting head and the reserve steps
+    std::atomic_flag res_lock = ATOMIC_FLAG_INIT;
+
+    /// Next position to be reserved
+    uint64_t head = { 0 };
+
+    /// Next position to be posted; only advanced by the flusher
+    std::atomic<uint64_t> tail = { 0 };
+
+    /// Set while a thread acts as the flusher
+    std::atomic_flag flushing = ATOMIC_FLAG_INIT;
+
+    /// Acquires the reservation lock
+    void lock();
+
+    /// Releases the reservation lock
+    void unlock();
+
+    /// Reserves the next position in the ring, waiting for a free slot if needed; must be called with the reservation lock held
+    uint64_t reserve();
+
+    /// Publishes a request in the slot at the given position
+    void publish(uint64_t pos, cSubmitReq *req);
+
+    /**
+     * @brief Tries to become the flusher and posts all the published requests, in order
+     * @return True if this thread acted as the flusher, false if another thread is currently flushing
+     */
+    bool flush();
+
+public:
+    cSubmitQueue();
+
+    cSubmitQueue(const cSubmitQueue&) = delete;
+    cSubmitQueue& operator=(const cSubmitQueue&) = delete;
+
+    /**
+     * @brief Submits a request and waits until it has been posted
+     *
+     * @param reserve_fn Reserve step, executed under the reservation lock; should be short
+     * @param post_fn Post step, executed by the flusher, in the order of the reserve steps
+     * @return The return value of the reserve step
+     * @note Exceptions thrown by the post step are re-thrown in the submitting thread
+     */
+    template <typename R, typename P>
+    auto submit(R &&reserve_fn, P &&post_fn) -> decltype(reserve_fn()) {
+        cSubmitReqImpl<P> req(post_fn);
+
+        lock();
+        uint64_t pos;
+        decltype(reserve_fn()) ret_val;
+        try {
+            pos = reserve();
+        } catch (...) {
+            unlock();
+            throw;
+        }
+        try {
+            ret_val = reserve_fn();
+        } catch (...) {
+            // Release the reserved position, which is still the last one, since the lock was held; otherwise, the flusher would wait for it forever
+            head = pos;
+            unlock();
+            throw;
+        }
+        unlock();
+
+        publish(pos, &req);
+        while (!req.done.load(std::memory_order_acquire)) {
+            if (!flush()) {
+                cpuRelax();
+            }
+        }
+
+        if (req.exc) {
+            std::rethrow_exception(req.exc);
+        }
+        return ret_val;
+    }
+
+    /// Executes a function under the reservation lock, i.e., without any concurrent reserve steps
+    template <typename F>
+    auto locked(F &&fn) -> decltype(fn()) {
+        lock();
+        try {
+            auto ret_val = fn();
+            unlock();
+            return ret_val;
+        } catch (...) {
+            unlock();
+            throw;
+        }
+    }
+};
+
+}
+
+#endif // _COYOTE_CSUBMITQUEUE_HPP_
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CSWEEP_HPP_
+#define _COYOTE_CSWEEP_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+#include "cBench.hpp"
+#include "cHistogram.hpp"
+
+namespace coyote {
+
+/// Default significance level of the regression test (see cSweep::compare)
+constexpr double const SWEEP_DEFAULT_ALPHA = 0.01;
+
+/// Default minimum relative change of the mean time, for a significant change to be reported as a regression or improvement
+constexpr double const SWEEP_DEFAULT_THRESHOLD = 0.05;
+
+/// One cell of a parameter sweep
+struct cSweepPoint {
+    /// Transfer size, in bytes
+    uint64_t size;
+
+    /// Benchmarked operation, e.g., "READ"; must not contain commas, quotes, backslashes or control characters
+    std::string oper;
+
+    /// Number of threads
+    unsigned int n_threads;
+
+    /// Queue depth, i.e., number of operations in flight
+    unsigned int queue_depth;
+
+    bool operator==(const cSweepPoint &other) const {
+        return size == other.size && oper == other.oper && n_threads == other.n_threads && queue_depth == other.queue_depth;
+    }
+};
+
+/// Grid of a parameter sweep; the cells are all the combinations of the parameters
+struct cSweepGrid {
+    std::vector<uint64_t> sizes;
+    std::vector<std::string> opers;
+    std::vector<unsigned int> threads = { 1 };
+    std::vector<unsigned int> queue_depths = { 1 };
+
+    /// Returns all the cells, in the order sizes, operations, threads, queue depths (i.e., the queue depth changes the fastest)
+    std::vector<cSweepPoint> getPoints() const;
+
+    /// Utility function, returning the powers of two from min_size to max_size (inclusive), e.g., for the transfer sizes
+    static std::vector<uint64_t> powersOfTwo(uint64_t min_size, uint64_t max_size);
+};
+
+/// Results of one cell of a parameter sweep; the times are per iteration of the benchmark, in ns
+struct cSweepResult {
+    cSweepPoint point;
+
+    /// Number of measured iterations, and statistics of their times
+    uint64_t n_samples;
+    double avg_time;
+    double std_dev;
+    double min_time;
+    double p50_time;
+    double p99_time;
+    double max_time;
+
+    /// Throughput, with the bounds of its 95% confidence interval
+    cBenchInterval ops_per_sec;
+    cBenchInterval bytes_per_sec;
+};
+
+/// Comparison of a cell to its baseline (see cSweep::compare)
+struct cSweepComparison {
+    cSweepPoint point;
+
+    /// Mean time per iteration, in the baseline and now, in ns
+    double baseline_time;
+    double time;
+
+    /// Relative change of the mean time; positive if the cell got slower (i.e., a higher latency and a lower throughput)
+    double change;
+
+    /// Two-sided p-value of Welch's t-test, comparing the mean times
+    double p_value;
+
+    /// Whether the change is significant and larger than the threshold
+    bool regression;
+    bool improvement;
+};
+
+/**
+ * @brief Declarative parameter sweep, with machine-readable output and regression checks against a baseline
+ *
+ * The sweep runs a benchmark for every cell of a grid of transfer sizes, operations, thread counts and queue depths,
+ * and collects the statistics of every cell. The results can be written as CSV or JSON, e.g., to plot them or to keep
+ * them as a baseline. A later run can then be compared to the baseline: every cell, whose mean time changed significantly
+ * (according to Welch's t-test) and by more than a threshold, is flagged as a regression or an improvement. Since the 
+ * throughput is derived from the mean time, a latency regression of a cell is also a throughput regression.
+ *
+ * The cells are either run with run(), which calls a function returning the cBench of a cell, or, if the times are 
+ * measured differently (e.g., by a timer in the vFPGA), by iterating over getPoints() and adding the results with add().
+ */
+class cSweep {
+
+private:
+    /// Name of the sweep, e.g., of the example; must not contain commas, quotes, backslashes or control characters
+    std::string name;
+
+    /// Grid of the sweep and the results of the cells run so far
+    cSweepGrid grid;
+    std::vector<cSweepResult> results;
+
+public:
+    /// Default constructor; the cells are run with run() or added with add()
+    cSweep(const std::string &name, const cSweepGrid &grid);
+
+    /// Returns all the cells of the grid, in the order they are run (see cSweepGrid::getPoints)
+    std::vector<cSweepPoint> getPoints() const;
+
+    /**
+     * @brief Runs all the cells of the grid
+     * @param cell_func Function running the benchmark of a cell; called with the cell (cSweepPoint), returns the cBench of the cell
+     */
+    template <class CellFunc>
+    const std::vector<cSweepResult>& run(CellFunc const &cell_func) {
+        for (const cSweepPoint &point : getPoints()) {
+            add(point, cell_func(point));
+        }
+        return results;
+    }
+
+    /// Adds the results of a cell, from the cBench that benchmarked it
+    void add(const cSweepPoint &point, const cBench &bench);
+
+    /**
+     * @brief Adds the results of a cell, from times measured outside of cBench
+     * @param point Cell
+     * @param times Times per iteration, in ns
+     * @param n_bytes Bytes moved by every iteration
+     * @param n_ops Operations completed by every iteration
+     */
+    void add(const cSweepPoint &point, const cHistogram &times, uint64_t n_bytes, uint64_t n_ops = 1);
+
+    /// Returns the results of the cells run so far
+    const std::vector<cSweepResult>& getResults() const;
+
+    /// Writes the results as CSV, with a header line
+    void writeCsv(std::ostream &out) const;
+
+    /// Writes the results as JSON
+    void writeJson(std::ostream &out) const;
+
+    /// Writes the results to a file; as JSON if the file name ends in .json, otherwise as CSV
+    void write(const std::string &path) const;
+
+    /// Reads the results of a sweep from a CSV file (see writeCsv), e.g., as the baseline for compare()
+    static std::vector<cSweepResult> readCsv(const std::string &path);
+
+    /**
+     * @brief Compares the results to a baseline, e.g., of a previous version
+     *
+     * Only the cells in both the results and the baseline are compared. A cell is a regression (improvement) if its mean time 
+     * is higher (lower) than in the baseline, the difference is significant at the given level and larger than the threshold.
+     *
+     * @param baseline Results of the baseline
+     * @param alpha Significance level of Welch's t-test
+     * @param threshold Minimum relative change of the mean time, e.g., to ignore small, but significant changes
+     */
+    std::vector<cSweepComparison> compare(
+        const std::vector<cSweepResult> &baseline, double alpha = SWEEP_DEFAULT_ALPHA, double threshold = SWEEP_DEFAULT_THRESHOLD
+    ) const;
+
+    /**
+     * @brief Prints the cells, which regressed or improved compared to a baseline
+     * @return Number of regressions, e.g., for the exit code of the benchmark in CI
+     */
+    static unsigned int printComparison(const std::vector<cSweepComparison> &comparison, std::ostream &out);
+};
+
+}
+
+#endif // _COYOTE_CSWEEP_HPP_
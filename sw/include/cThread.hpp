@@ -27,9 +27,11 @@
 #ifndef _COYOTE_CTHREAD_HPP_
 #define _COYOTE_CTHREAD_HPP_
 
+#include <mutex>
 #include <thread>
 #include <chrono>
 #include <string>
+#include <vector>
 #include <random>
 #include <fstream>
 #include <iostream>
@@ -57,6 +59,12 @@
 #include "cDefs.hpp"
 #include "cOps.hpp"
 #include "cGpu.hpp"
+#include "cCmplQueue.hpp"
+#include "cFuture.hpp"
+#include "cRegCache.hpp"
+#include "cSubmitQueue.hpp"
+#include "cStats.hpp"
+#include "cTrace.hpp"
 
 namespace coyote {
 
@@ -70,9 +78,12 @@ namespace coyote {
  */
 class cThread {
 protected: 
-	/// vFPGA device file descriptor
+	/// vFPGA device file descriptor; shared by all the cThreads of the process on the same vFPGA (see releaseShellCache)
 	int32_t fd = { 0 };
 
+	/// Device number, for systems with multiple vFPGAs
+	uint32_t device = { 0 };
+
 	/// vFPGA virtual ID
 	int32_t vfid = { -1 };
 	
@@ -88,8 +99,47 @@ protected:
 	/// RDMA queue pair
     std::unique_ptr<ibvQp> qpair; 
 
-	/// Number data transfer commands sent to the vFPGA
-	uint32_t cmd_cnt = { 0 };
+	/**
+	 * Shadow counter of the free entries (credits) in the vFPGA command FIFO
+	 * Decremented for every posted command and only refreshed from the hardware (an uncached read of CTRL_REG) once it runs out
+	 */
+	uint32_t cmd_credits = { CMD_FIFO_DEPTH - CMD_FIFO_THR + 1 };
+
+	/// Policy for waiting on the command FIFO, once it's full
+	CoyoteBackoff backoff = { CoyoteBackoff::SPIN_YIELD };
+
+	/// Host-side statistics: operations, commands, bytes, stalls, waits, CSR accesses, mapping ioctls and interrupts (see getStats)
+	mutable cThreadCounters counters;
+
+	/// Operation, whose commands are currently being posted; set by submitCmds, so that postCmds can attribute the commands
+	CoyoteOper post_oper = { CoyoteOper::NOOP };
+
+	/// Completion tokens of the issued commands, resolved against the completion counters
+	cCmplQueue cmpl_queue;
+
+	/// Submission queue, serializing the commands of multiple application threads; only allocated in multi-producer mode (see setMultiProducer)
+	std::unique_ptr<cSubmitQueue> submit_queue;
+
+	/// Maximum length of a single DMA command; longer transfers are split into multiple commands (see setChunkSize)
+	uint32_t chunk_size = { MAX_TRANSFER_SIZE };
+
+	/// NUMA node of the vFPGA's device, as reported by sysfs; -1 if unknown (e.g., on single-socket systems)
+	int32_t numa_node = { -1 };
+
+	/// CPUs on the same NUMA node as the vFPGA's device, as reported by sysfs; used by pinToDevice()
+	std::vector<uint32_t> local_cpus;
+
+	/// Registration cache for buffers that weren't allocated with getMem (see setRegCache)
+	cRegCache reg_cache {
+		[this](void *vaddr, uint32_t len) { mapUserMem(vaddr, len); },
+		[this](void *vaddr) { unmapUserMem(vaddr); }
+	};
+
+	/// User interrupt service routine, if provided in the constructor
+	void (*uisr)(int) = { nullptr };
+
+	/// Guards the lazy start of the user interrupt thread (see startEventThread)
+	std::once_flag event_once;
 
 	/// User interrupt file descriptor
 	int32_t efd = { -1 };
@@ -97,9 +147,21 @@ protected:
 	/// Termination event file descriptor for stopping the user interrupt thread
 	int32_t terminate_efd = { -1 };
 
+	/// Event file descriptor for waking up threads blocked in waitCompleted; signalled by the user interrupt thread
+	int32_t wait_efd = { -1 };
+
+	/// Time spent spinning in waitCompleted, before blocking (see setWaitSpin)
+	std::chrono::nanoseconds wait_spin { WAIT_SPIN_TIME };
+
 	/// Dedicated thread for handling user interrupts
 	std::thread event_thread;
 
+	/// CPUs the user interrupt thread is pinned to, once it's started; set by pinToDevice(), empty if not pinned
+	std::vector<uint32_t> event_cpus;
+
+	/// Protects event_cpus and event_thread, so that pinToDevice() and the lazy start of the user interrupt thread don't race
+	std::mutex event_mtx;
+
 	/// vFPGA config registers, if AVX is enabled, as implemented in cnfg_slave_avx.sv; used mainly for starting DMA commands
 	#ifdef EN_AVX
 	volatile __m256i *cnfg_reg_avx = { 0 };
@@ -133,18 +195,37 @@ protected:
 	/// Set to true if there is an active out-of-band connection to a remote node for this cThread
 	bool is_connected;
 
-	/// Inter-process vFPGA lock, see lock() and unlock() functions for more details
-	boost::interprocess::named_mutex vlock;
+	/// Inter-process vFPGA lock, see lock() and unlock() functions for more details; only opened on the first call to lock()
+	std::unique_ptr<boost::interprocess::named_mutex> vlock;
 
 	/// Set to true if the vFPGA lock is acquired by this cThread; used to release the lock in the destructor
 	bool lock_acquired = { false };
 	
-	/// Utility function, memory mapping all the vFPGA control registers and writeback regions
+	/**
+	 * @brief Utility function, memory mapping all the vFPGA control registers and writeback regions
+	 *
+	 * The device file, the shell configuration, the sysfs attributes and the mapped regions are cached per vFPGA for the 
+	 * entire process, so only the first cThread on a vFPGA opens the device, reads the configuration and maps the regions.
+	 */
 	void mmapFpga();
 
-	/// Utility function, unmapping all the vFPGA control registers and writeback regions
+	/// Utility function, releasing the cached vFPGA mappings; they stay mapped until releaseShellCache() is called
 	void munmapFpga();
 
+	/**
+	 * @brief Utility function, starting the user interrupt thread, if a user interrupt service routine was provided
+	 *
+	 * The thread (and its event file descriptors) is only started once the vFPGA can raise an interrupt for this cThread,
+	 * i.e., on the first command, CSR access, blocking wait or RDMA set-up, which keeps the constructor cheap.
+	 */
+	void startEventThread();
+
+	/// Utility function, maps a buffer to the vFPGA's TLB in the driver, without tracking it in the registration cache
+	void mapUserMem(void *vaddr, uint32_t len);
+
+	/// Utility function, unmaps a buffer from the vFPGA's TLB in the driver, without tracking it in the registration cache
+	void unmapUserMem(void *vaddr);
+
 	/**
 	 * @brief Posts a DMA command to the vFPGA
 	 *
@@ -157,6 +238,104 @@ protected:
 	 */
 	void postCmd(uint64_t offs_3, uint64_t offs_2, uint64_t offs_1, uint64_t offs_0);
 
+	/**
+	 * @brief Posts a sequence of DMA commands to the vFPGA, back-to-back
+	 *
+	 * The command FIFO is only queried (an uncached read of CTRL_REG) when the shadow credit counter 
+	 * runs out. Then, all the commands that fit in the FIFO are written without any further checks.
+	 *
+	 * @param cmds Pointer to the commands to be posted, in order
+	 * @param n_cmds Number of commands to be posted
+	 */
+	void postCmds(const cmdDesc *cmds, uint32_t n_cmds);
+
+	/**
+	 * @brief Waits until there is space in the command FIFO and returns the number of commands that can be posted
+	 *
+	 * If the shadow credit counter has run out, the credits are refreshed from the hardware; while the FIFO
+	 * is full, the function waits according to the selected backoff policy and records the stall.
+	 *
+	 * @param n_cmds Number of commands the caller would like to post
+	 * @return Number of commands (at least one, at most n_cmds) that can be posted without over-saturating the FIFO
+	 * @note The returned credits are consumed by the caller, i.e., the shadow credit counter is decremented accordingly
+	 */
+	uint32_t acquireCmdCredits(uint32_t n_cmds);
+
+	/// Utility function, reads the number of outstanding commands in the vFPGA command FIFO
+	uint32_t readCmdCnt() const;
+
+	/// Utility function, writes a single command to the config registers; doesn't check for FIFO space
+	void writeCmd(const cmdDesc &cmd);
+
+	/**
+	 * @brief Utility function, encodes the control word of a local (host or card memory) DMA command
+	 *
+	 * @param sg Scatter-gather entry, specifying the length, stream and destination of the command
+	 * @param last Indicates whether this is the last command in a sequence
+	 * @return Control word, as expected by the vFPGA config registers
+	 */
+	uint64_t localCtrlCmd(const localSg &sg, bool last) const;
+
+	/**
+	 * @brief Utility function, encodes an RDMA command
+	 *
+	 * @param oper RDMA operation (read, write or send)
+	 * @param sg Scatter-gather entry, specifying the offsets, streams and length of the command
+	 * @param last Indicates whether this is the last command in a sequence
+	 * @return Command, with the local and remote side ordered as source and destination, depending on the operation
+	 */
+	cmdDesc rdmaCmd(CoyoteOper oper, const rdmaSg &sg, bool last) const;
+
+	/// Utility function, returns the number of commands (chunks) needed for a transfer of the given length; at least one
+	uint32_t getNumChunks(uint64_t len) const;
+
+	/**
+	 * @brief Utility function, posts the commands of a local operation, split into chunks of at most chunk_size bytes
+	 *
+	 * The entries of each side are treated as one contiguous stream of chunks. The i-th command carries the i-th chunk 
+	 * of the source and the i-th chunk of the destination; once one side has no more chunks, the remaining commands 
+	 * are one-sided. Only the final chunk of the final entry of each side is flagged as last.
+	 *
+	 * @param src_sgs Source scatter-gather entries, or nullptr for operations without a source (LOCAL_WRITE)
+	 * @param n_src Number of source entries
+	 * @param dst_sgs Destination scatter-gather entries, or nullptr for operations without a destination (LOCAL_READ)
+	 * @param n_dst Number of destination entries
+	 * @param last Indicates whether the final chunk is the last operation in a sequence
+	 */
+	void postLocalCmds(const localSg *src_sgs, size_t n_src, const localSg *dst_sgs, size_t n_dst, bool last);
+
+	/**
+	 * @brief Utility function, issues the completion token of an operation and posts its commands
+	 *
+	 * In multi-producer mode (see setMultiProducer), both steps go through the submission queue, so that the tokens are
+	 * issued in the same order as the commands reach the vFPGA and the commands of one operation are posted back-to-back.
+	 *
+	 * @param oper Operation type, used for the completion token
+	 * @param last Indicates whether the operation is flagged as last, i.e., whether it increments the completion counter
+	 * @param post_fn Function posting the commands of the operation (e.g., with postCmds)
+	 * @return Completion token of the operation
+	 */
+	template <typename P>
+	cmplToken submitCmds(CoyoteOper oper, bool last, P &&post_fn) {
+		TRACE_BEGIN(trace_begin);
+		statAdd(counters.n_ops[static_cast<uint32_t>(oper)]);
+		auto post_oper_fn = [&]() {
+			post_oper = oper;
+			post_fn();
+		};
+
+		cmplToken token;
+		if (!submit_queue) {
+			token = cmpl_queue.issue(oper, last);
+			post_oper_fn();
+		} else {
+			token = submit_queue->submit([&]() { return cmpl_queue.issue(oper, last); }, post_oper_fn);
+		}
+
+		TRACE_END(trace_begin, cTraceEvent::INVOKE, ctid, static_cast<uint64_t>(oper), token);
+		return token;
+	}
+
 	/**
 	 * @brief Sends an ack to the connected remote node via the out-of-band channel
 	 *
@@ -203,6 +382,26 @@ public:
 	 */
 	~cThread();
 
+	/**
+	 * @brief Resets the cThread, so that it can be reused (e.g., for the next request in a service) instead of being re-created
+	 *
+	 * Clears the completion counters and tokens, fails any outstanding futures (see invokeAsync), drops pending 
+	 * interrupt wakeups and releases the vFPGA lock, if acquired. The ctid, the mapped buffers (including the 
+	 * registration cache), the RDMA connection and the settings (chunk size, backoff, wait spin) are kept, 
+	 * as are the cumulative statistics (see getStats).
+	 *
+	 * @note Must only be called when no operations are in flight, since their completions would be counted after the reset
+	 */
+	void reset();
+
+	/**
+	 * @brief Releases the process-wide cache of vFPGA device files, shell configurations and register mappings
+	 *
+	 * Cached entries are kept after the last cThread on a vFPGA is destroyed, so that re-creating a cThread doesn't repeat
+	 * the driver calls. This function unmaps and closes the entries without any cThreads; e.g., after a shell reconfiguration.
+	 */
+	static void releaseShellCache();
+
 	/**
 	 * @brief Maps a buffer to the vFPGAs TLB
 	 *
@@ -249,6 +448,35 @@ public:
 	 * @return Value of the register at the specified offset
 	 */
 	uint64_t getCSR(uint32_t offs) const ;
+
+	/**
+	 * @brief Sets consecutive control registers in the vFPGA, starting at the specified offset
+	 *
+	 * Equivalent to calling setCSR(vals[i], offs + i) for all the values, in order, but with fewer MMIO writes:
+	 * if the shell supports AVX (see fpgaCnfg::en_avx), every aligned group of four registers is written 
+	 * with one 256-bit store. The stores are followed by a single store fence, so all the registers are written 
+	 * before any subsequent MMIO write (e.g., a command or a final setCSR that starts the kernel).
+	 *
+	 * @param offs Offset of the first control register to be set
+	 * @param vals Register values to be set
+	 * @param n Number of registers
+	 */
+	void setCSRs(uint32_t offs, const uint64_t *vals, uint32_t n);
+
+	/// Same as above, for the values in the vector
+	void setCSRs(uint32_t offs, const std::vector<uint64_t> &vals);
+
+	/**
+	 * @brief Reads consecutive registers in the vFPGA, starting at the specified offset
+	 *
+	 * Equivalent to calling getCSR(offs + i) for all the registers, but, if the shell supports AVX, 
+	 * every aligned group of four registers is read with one 256-bit load, saving three round-trips over PCIe.
+	 *
+	 * @param offs Offset of the first register to be read
+	 * @param vals Output; values of the registers
+	 * @param n Number of registers
+	 */
+	void getCSRs(uint32_t offs, uint64_t *vals, uint32_t n) const;
 	
 	// The following functions are various implementation of the invoke function, which are used to trigger data movement operations
 	// There are different implementation for the different types of operations (sync, local, rdma, tcp) to ensure type safety at compile-time
@@ -259,9 +487,11 @@ public:
 	 * @param oper Operation be invoked, in this case must be either CoyoteOper::LOCAL_SYNC or CoyoteOper::LOCAL_OFFLOAD
 	 * @param sg Scatter-gather entry, specifying the memory address and length for the operation
 	 *
+	 * @return Always CMPL_TOKEN_NONE, since the operation is already completed on return
+	 *
 	 * @note Syncs and off-loads are blocking (synchronous) by design
 	 */
-	void invoke(CoyoteOper oper, syncSg sg);
+	cmplToken invoke(CoyoteOper oper, syncSg sg);
 
 	/**
 	 * @brief Invokes a one-sided local Coyote operation with the specified scatter-gather list (sg)
@@ -269,11 +499,12 @@ public:
 	 * @param oper Operation be invoked, in this case must be either CoyoteOper::LOCAL_READ or CoyoteOper::LOCAL_WRITE
 	 * @param sg Scatter-gather entry, specifying the memory address, length and stream for the operation
 	 * @param last Indicates whether this is the last operation in a sequence (default: true)
+	 * @return Completion token of the operation, see isCompleted() and pollCompletions()
 	 *
- 	 * @note Local operations are non-blocking (asynchronous) by design, so users should poll for completion using checkCompleted()
+ 	 * @note Local operations are non-blocking (asynchronous) by design, so users should poll for completion using checkCompleted(), isCompleted() or pollCompletions()
 	 * @note Whenever last is passed as true, the completion counter for the operation is incremented by 1 and an acknowledgement is sent on the hardware-side cq_* interface of the vFPGA with ack_t.host = 1; otherwise it is not
 	 */
-	void invoke(CoyoteOper oper, localSg sg, bool last = true);
+	cmplToken invoke(CoyoteOper oper, localSg sg, bool last = true);
 
 	/**
 	 * @brief Invokes a two-sided local Coyote operation with the specified scatter-gather list (sg)
@@ -282,11 +513,43 @@ public:
 	 * @param src_sg Source scatter-gather entry, specifying the memory address, length and stream
 	 * @param dst_sg Destination scatter-gather entry, specifying the memory address, length and stream
 	 * @param last Indicates whether this is the last operation in a sequence (default: true)
+	 * @return Completion token of the operation, see isCompleted() and pollCompletions()
 	 *
- 	 * @note Local operations are non-blocking (asynchronous) by design, so users should poll for completion using checkCompleted()
+ 	 * @note Local operations are non-blocking (asynchronous) by design, so users should poll for completion using checkCompleted(), isCompleted() or pollCompletions()
 	 * @note Whenever last is passed as true, the completion counter for the operation is incremented by 1 and an acknowledgement is sent on the hardware-side cq_* interface of the vFPGA with ack_t.host = 1; otherwise it is not
 	 */
-	void invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last = true);
+	cmplToken invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last = true);
+
+	/**
+	 * @brief Invokes a one-sided local Coyote operation on a list of non-contiguous buffers, without copying them
+	 *
+	 * The buffers are streamed into (LOCAL_READ) or out of (LOCAL_WRITE) the vFPGA stream as one logical packet, in order. 
+	 * That is, one command is posted per buffer (or per chunk, for buffers longer than the chunk size), and only the 
+	 * final one is (optionally) flagged as last, so the whole list is counted as a single completion.
+	 *
+	 * @param oper Operation be invoked, in this case must be either CoyoteOper::LOCAL_READ or CoyoteOper::LOCAL_WRITE
+	 * @param sg_list Scatter-gather entries, one for each buffer; the stream and dest of each entry are used for its commands
+	 * @param last Indicates whether this is the last operation in a sequence (default: true)
+	 * @return Completion token of the operation, see isCompleted() and pollCompletions()
+	 *
+	 * @note All the buffers must be mapped to the vFPGA, e.g., allocated with getMem() or mapped with userMap()
+	 */
+	cmplToken invoke(CoyoteOper oper, const sgList &sg_list, bool last = true);
+
+	/**
+	 * @brief Invokes a two-sided local Coyote operation, gathering from a list of source buffers and scattering to a list of destination buffers
+	 *
+	 * The source and destination lists don't need to have the same number of entries, nor do the entries need to have the same lengths.
+	 * The source buffers are streamed into the vFPGA as one logical packet and the destination buffers are filled in order, as the data is 
+	 * written by the vFPGA.
+	 *
+	 * @param oper Operation be invoked, in this case must be CoyoteOper::LOCAL_TRANSFER
+	 * @param src_list Source scatter-gather entries
+	 * @param dst_list Destination scatter-gather entries
+	 * @param last Indicates whether this is the last operation in a sequence (default: true)
+	 * @return Completion token of the operation, see isCompleted() and pollCompletions()
+	 */
+	cmplToken invoke(CoyoteOper oper, const sgList &src_list, const sgList &dst_list, bool last = true);
 
 	/**
 	 * @brief Invokes an RDMA Coyote operation with the specified scatter-gather list (sg)
@@ -294,11 +557,12 @@ public:
 	 * @param oper Operation be invoked, in this case must be CoyoteOper::RDMA_WRITE or CoyoteOper::RDMA_READ
 	 * @param sg Scatter-gather entry, specifying the RDMA operation parameters 
 	 * @param last Indicates whether this is the last operation in a sequence (default: true)
+	 * @return Completion token of the operation, see isCompleted() and pollCompletions()
 	 *
- 	 * @note Remote oeprations are non-blocking (asynchronous) by design, so users should poll for completion using checkCompleted()
+ 	 * @note Remote oeprations are non-blocking (asynchronous) by design, so users should poll for completion using checkCompleted(), isCompleted() or pollCompletions()
 	 * @note Whenever last is passed as true, the completion counter for the operation is incremented by 1 and an acknowledgement is sent on the hardware-side cq_* interface of the vFPGA with ack_t.host = 1; otherwise it is not
 	 */
-	void invoke(CoyoteOper oper, rdmaSg sg, bool last = true);
+	cmplToken invoke(CoyoteOper oper, rdmaSg sg, bool last = true);
 
 	/**
 	 * @brief Invokes an RDMA Coyote operation with the specified scatter-gather list (sg)
@@ -307,9 +571,74 @@ public:
 	 * @param sg Scatter-gather entry, specifying the RDMA operation parameters 
 	 * @param last Indicates whether this is the last operation in a sequence (default: true)
 	 *
+	 * @return Always CMPL_TOKEN_NONE, since TCP operations aren't tracked by the completion counters
+	 *
 	 * @note TCP operations aren't fully stable in Coyote 0.2.1, to be updated in the future
 	 */
-	void invoke(CoyoteOper oper, tcpSg sg, bool last = true);
+	cmplToken invoke(CoyoteOper oper, tcpSg sg, bool last = true);
+
+	/**
+	 * @brief Invokes a batch of one-sided local Coyote operations with a single call
+	 *
+	 * The arguments are validated once for the entire batch and the FIFO credits are acquired for as many
+	 * commands as possible at once, so that the commands can be streamed to the vFPGA back-to-back.
+	 * This significantly reduces the per-command CPU cost when issuing many small transfers.
+	 *
+	 * @param oper Operation be invoked, in this case must be either CoyoteOper::LOCAL_READ or CoyoteOper::LOCAL_WRITE
+	 * @param sg_list Scatter-gather entries, one for each command in the batch
+	 * @param last Indicates whether the final command in the batch is the last operation in a sequence (default: true)
+	 * @return Completion token of the final command in the batch, which is completed once the entire batch is completed
+	 *
+	 * @note Only the final command in the batch is (optionally) flagged as last; therefore, the completion counter is incremented
+	 * by 1 for the entire batch, rather than once for every command.
+	 */
+	cmplToken invokeBatch(CoyoteOper oper, const std::vector<localSg> &sg_list, bool last = true);
+
+	/**
+	 * @brief Invokes a batch of two-sided local Coyote operations with a single call
+	 *
+	 * @param oper Operation be invoked, in this case must be CoyoteOper::LOCAL_TRANSFER
+	 * @param sg_list Pairs of source and destination scatter-gather entries, one pair for each command in the batch
+	 * @param last Indicates whether the final command in the batch is the last operation in a sequence (default: true)
+	 * @return Completion token of the final command in the batch
+	 *
+	 * @note Same as above, only the final command in the batch is (optionally) flagged as last
+	 */
+	cmplToken invokeBatch(CoyoteOper oper, const std::vector<std::pair<localSg, localSg>> &sg_list, bool last = true);
+
+	/**
+	 * @brief Invokes a one-sided local Coyote operation asynchronously, returning a future for its completion
+	 *
+	 * The operation is invoked as with invoke() and registered with the process-wide cReactor, which polls 
+	 * the completion counters of all cThreads from a single thread. Therefore, the calling thread doesn't need 
+	 * to spin on checkCompleted() and it can wait for the operation (or chain a continuation) using the future.
+	 *
+	 * @param oper Operation be invoked, in this case must be either CoyoteOper::LOCAL_READ or CoyoteOper::LOCAL_WRITE
+	 * @param sg Scatter-gather entry, specifying the memory address, length and stream for the operation
+	 * @return Future, which is completed once the operation is completed
+	 *
+	 * @note The operation is always flagged as last, since only those are counted by the completion counters
+	 */
+	cFuture invokeAsync(CoyoteOper oper, localSg sg);
+
+	/**
+	 * @brief Invokes a two-sided local Coyote operation asynchronously, returning a future for its completion
+	 *
+	 * @param oper Operation be invoked, in this case must be CoyoteOper::LOCAL_TRANSFER
+	 * @param src_sg Source scatter-gather entry, specifying the memory address, length and stream
+	 * @param dst_sg Destination scatter-gather entry, specifying the memory address, length and stream
+	 * @return Future, which is completed once the operation is completed
+	 */
+	cFuture invokeAsync(CoyoteOper oper, localSg src_sg, localSg dst_sg);
+
+	/**
+	 * @brief Invokes an RDMA Coyote operation asynchronously, returning a future for its completion
+	 *
+	 * @param oper Operation be invoked, in this case must be CoyoteOper::RDMA_WRITE or CoyoteOper::RDMA_READ
+	 * @param sg Scatter-gather entry, specifying the RDMA operation parameters 
+	 * @return Future, which is completed once the operation is completed
+	 */
+	cFuture invokeAsync(CoyoteOper oper, rdmaSg sg);
 
 	/**
 	 * @brief Returns the number of completed operations for a given Coyote operation type
@@ -319,11 +648,88 @@ public:
 	 */
 	uint32_t checkCompleted(CoyoteOper oper) const;
 
+	/**
+	 * @brief Waits until the number of completed operations of a given type reaches a target, without occupying a CPU core
+	 *
+	 * The completion counter is first polled for a short time (see setWaitSpin), which keeps the latency low for short operations.
+	 * Afterwards, the calling thread blocks and re-checks the counter with exponentially increasing intervals (up to 1 ms).
+	 * If a user interrupt service routine was registered in the constructor, every interrupt from the vFPGA also wakes up 
+	 * the waiting thread, so vFPGAs that raise an interrupt on completion are detected immediately.
+	 *
+	 * @param oper Operation to be waited for
+	 * @param count Target number of completed operations, as returned by checkCompleted()
+	 * @param timeout Maximum time to wait; by default, the wait doesn't time out
+	 * @return True if the target was reached, false if the wait timed out
+	 */
+	bool waitCompleted(CoyoteOper oper, uint32_t count, std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max());
+
+	/**
+	 * @brief Sets the time spent spinning in waitCompleted, before blocking
+	 * @param spin Spin budget; zero blocks immediately (default: 20 us)
+	 */
+	void setWaitSpin(std::chrono::nanoseconds spin);
+
+	/// Getter: Statistics on blocking waits (number of waits, sleeps, interrupt wakeups and final sleep duration)
+	cmplWaitStats getWaitStats() const;
+
 	/**
 	 * @brief Clears all the completion counters (for all operations)
+	 * @note Also resets the completion tokens; tokens issued before this call must not be used afterwards
 	 */
 	void clearCompleted();
 
+	/**
+	 * @brief Checks whether the operation with the given token is completed
+	 *
+	 * Operations invoked with last = false share the token of the next operation in the same class invoked with last = true,
+	 * since the completion counters are only incremented for operations flagged as last.
+	 *
+	 * @param token Token, as returned by invoke() or invokeBatch()
+	 * @return true if the operation is completed; always true for CMPL_TOKEN_NONE
+	 */
+	bool isCompleted(cmplToken token);
+
+	/**
+	 * @brief Drains the completed operations of this cThread in bulk
+	 *
+	 * The completion counters are read (once per operation class with outstanding operations) and all the operations 
+	 * that have completed since the last call are returned, in issue order within each class. This allows, for example, 
+	 * ring-buffer pipelines to recycle a buffer as soon as the transfer using it is completed.
+	 *
+	 * @param cmpls Array to be filled with the completed operations
+	 * @param n_cmpls Size of the array; at most this many completions are returned, the rest are kept for the next call
+	 * @return Number of completions written to cmpls
+	 *
+	 * @note Only operations invoked with last = true, after the completion queue was enabled (see setCompletionQueue), are returned.
+	 * At most CMPL_QUEUE_DEPTH operations per class can be outstanding; beyond that, invoking an operation throws.
+	 * @throws std::runtime_error if the completion queue isn't enabled
+	 */
+	uint32_t pollCompletions(cmplEntry *cmpls, uint32_t n_cmpls);
+
+	/**
+	 * @brief Enables or disables the completion queue, which keeps the invoked operations for pollCompletions()
+	 *
+	 * The queue is disabled by default, so that users of checkCompleted(), isCompleted() or invokeAsync() don't pay for it.
+	 * It should be enabled before invoking the operations to be polled; disabling it drops the operations not yet polled.
+	 *
+	 * @note Must not be called concurrently with other operations, even in multi-producer mode
+	 */
+	void setCompletionQueue(bool enable);
+
+	/**
+	 * @brief Enables or disables thread-safe submission from multiple application threads
+	 *
+	 * By default, a cThread must only be used by one application thread at a time, since posting a command 
+	 * writes multiple registers and updates the shadow credit counter. In multi-producer mode, many threads 
+	 * can invoke operations on the same cThread (and hence share one ctid) concurrently. The operations are 
+	 * published in a lock-free submission queue and posted to the vFPGA by a single flusher at a time; 
+	 * the flusher is one of the submitting threads, which posts the operations of all the others in a batch.
+	 *
+	 * @param enable If true, invoke(), invokeBatch(), invokeAsync(), isCompleted() and pollCompletions() can be called concurrently
+	 * @note This function itself, as well as memory management and clearCompleted(), must not be called concurrently with other operations
+	 */
+	void setMultiProducer(bool enable);
+
 	/** 
 	 * @brief Synchronizes the connection between the client and server
 	 * @param client If true, this cThread acts as a client; otherwise, it acts as a server
@@ -364,6 +770,80 @@ public:
 	 */
 	void unlock();
 
+	/**
+	 * @brief Sets the policy for waiting on space in the vFPGA command FIFO, once it's full
+	 *
+	 * @param backoff Backoff policy; see CoyoteBackoff for the available options (default: CoyoteBackoff::SPIN_YIELD)
+	 */
+	void setBackoff(CoyoteBackoff backoff);
+
+	/// Getter: Statistics on command submission stalls (number of stalls, FIFO polls and time spent waiting)
+	cmdStallStats getStallStats() const;
+
+	/**
+	 * @brief Sets the maximum length of a single DMA command
+	 *
+	 * Local, sync/offload and RDMA transfers longer than this are transparently split into multiple commands by invoke(), 
+	 * which are pipelined against the free space in the command FIFO. Only the final command is flagged as last,
+	 * so the transfer is still counted as a single completion by checkCompleted().
+	 *
+	 * @param chunk_size Chunk size in bytes; must be non-zero and at most MAX_TRANSFER_SIZE (the default)
+	 */
+	void setChunkSize(uint32_t chunk_size);
+
+	/// Getter: Maximum length of a single DMA command, see setChunkSize()
+	uint32_t getChunkSize() const;
+
+	/**
+	 * @brief Enables or disables the registration cache for buffers that weren't allocated with getMem
+	 *
+	 * When enabled, invoke() registers any host buffer that isn't mapped yet (as with userMap), instead of relying on 
+	 * page faults in the vFPGA. Registrations are cached and re-used by later operations; adjacent registrations are merged
+	 * and the least recently used ones are unregistered once the pinned memory exceeds the budget. Buffers allocated 
+	 * with getMem or mapped with userMap are recognized and never registered again.
+	 *
+	 * @param enable If true, unregistered buffers are registered lazily by invoke(); if false, all cached registrations are released
+	 * @param budget Maximum memory kept pinned by the cache, in bytes (default: 1 GB)
+	 * @note Buffers must be invalidated with invalidateRegCache() before they are freed, see cRegCache for more details
+	 */
+	void setRegCache(bool enable, uint64_t budget = REG_CACHE_BUDGET);
+
+	/**
+	 * @brief Releases all the cached registrations overlapping a buffer; must be called before the buffer is freed
+	 *
+	 * @param addr Buffer address
+	 * @param len Buffer length, in bytes
+	 */
+	void invalidateRegCache(const void *addr, uint64_t len);
+
+	/// Getter: Statistics of the registration cache (hits, misses, evictions and pinned memory)
+	cRegCacheStats getRegCacheStats();
+
+	/**
+	 * @brief Returns a snapshot of the host-side statistics of this cThread
+	 *
+	 * The statistics are always collected, using relaxed atomic counters, and cover the invoked operations, 
+	 * posted commands and bytes per operation, command FIFO stalls, blocking waits, control register accesses, 
+	 * page-mapping ioctls, user interrupts and the registration cache. They can be exported with toJson() or toPrometheus().
+	 */
+	cThreadStats getStats();
+
+	/**
+	 * @brief Pins the calling thread and the user interrupt thread (if any) to the CPUs on the same NUMA node as the vFPGA's device
+	 *
+	 * On multi-socket systems, DMA to and from memory on a remote socket, as well as MMIO from a remote CPU, have to cross 
+	 * the inter-socket link, which reduces the throughput and increases the latency. Together with the default placement of 
+	 * memory from getMem (see CoyoteAlloc::numa_node), this keeps the entire data path on the device's socket.
+	 * The user interrupt thread is only started on first use (e.g., the first waitCompleted); if it hasn't been 
+	 * started yet, the CPUs are stored and the thread is pinned to them once it starts.
+	 *
+	 * @return True if the threads were pinned; false if the device's local CPUs are unknown (e.g., on single-socket systems)
+	 */
+	bool pinToDevice();
+
+	/// Getter: NUMA node of the vFPGA's device; -1 if unknown
+	int32_t getNumaNode() const;
+
 	/// Getter: vFPGA ID (vfid)
 	int32_t getVfid() const;
 
@@ -0,0 +1,226 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CTHREADPOOL_HPP_
+#define _COYOTE_CTHREADPOOL_HPP_
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "cDefs.hpp"
+#include "cOps.hpp"
+#include "cFuture.hpp"
+#include "cThread.hpp"
+
+namespace coyote {
+
+/// Destination stream of a localSg, which lets the pool pick any idle host stream (see cThreadPool)
+constexpr uint32_t const DEST_ANY = ~0u;
+
+/// Statistics of a cThreadPool, summed over all workers
+struct cThreadPoolStats {
+    /// Number of executed transfers
+    uint64_t n_executed = { 0 };
+
+    /// Number of transfers executed by a worker other than the one they were queued to
+    uint64_t n_stolen = { 0 };
+
+    /// Number of transfers currently queued or in flight
+    uint64_t n_pending = { 0 };
+};
+
+/**
+ * @brief A pool of Coyote threads, which dispatches local transfers across the ctids and host streams of a vFPGA
+ *
+ * The pool owns one cThread (and hence one ctid) per worker and each worker runs on its own software thread. 
+ * Every worker has a queue of pending transfers; a worker executes one transfer at a time, 
+ * by invoking it through its cThread and waiting for its completion. 
+ *
+ * Transfers respect the stream affinity of localSg::dest:
+ *  - Transfers with a fixed dest are queued to the worker dest % n_workers. On every host stream, at most one transfer 
+ *    is in flight at any time and the transfers start in the order they were submitted, so stateful vFPGA logic 
+ *    (e.g., the per-stream IV in Example 8) sees the data of one transfer at a time.
+ *  - Transfers with dest = DEST_ANY are queued round-robin and executed on any idle host stream.
+ *
+ * Idle workers steal transfers from the queues of other workers, provided the transfer's stream is idle. 
+ * Therefore, a few large transfers don't hold up the small transfers queued behind them and all host streams 
+ * are kept busy, even with skewed transfer sizes.
+ *
+ * @note A worker busy-polls for the completion of its transfer, so every busy worker occupies one CPU core; 
+ *       the number of workers should therefore not exceed the number of cores available to the application.
+ *       Idle workers sleep and are woken up one at a time, for every transfer that becomes runnable.
+ * @note Buffers must be allocated with getMem(), or mapped with userMap(), which map them into all the cThreads of the pool
+ */
+class cThreadPool {
+
+private:
+    /// A queued transfer
+    struct cPoolTask {
+        /// Operation; one of LOCAL_READ, LOCAL_WRITE, LOCAL_TRANSFER
+        CoyoteOper oper = { CoyoteOper::NOOP };
+
+        /// Source and destination scatter-gather entries
+        localSg src_sg, dst_sg;
+
+        /// Host stream the transfer must run on, or DEST_ANY
+        uint32_t dest = { DEST_ANY };
+
+        /// Completed once the transfer has completed
+        cPromise promise;
+    };
+
+    /// Per-worker state
+    struct cPoolWorker {
+        /// Protects the queue
+        std::mutex mtx;
+
+        /// Pending transfers, in submission order
+        std::deque<cPoolTask> queue;
+
+        /// Number of executed and stolen transfers
+        std::atomic<uint64_t> n_executed = { 0 }, n_stolen = { 0 };
+
+        /// Software thread of the worker
+        std::thread thread;
+    };
+
+    /// One Coyote thread per worker
+    std::vector<std::unique_ptr<cThread>> cthreads;
+
+    /// Workers
+    std::vector<std::unique_ptr<cPoolWorker>> workers;
+
+    /// For every host stream, whether a transfer is currently in flight on it
+    std::unique_ptr<std::atomic<bool>[]> strm_busy;
+
+    /// Number of host streams of the vFPGA
+    uint32_t n_streams;
+
+    /// Next worker for DEST_ANY transfers
+    std::atomic<uint32_t> next_worker = { 0 };
+
+    /// Number of queued or in-flight transfers
+    std::atomic<uint64_t> n_pending = { 0 };
+
+    /// Number of queued transfers, which haven't been taken by a worker yet
+    std::atomic<uint64_t> n_queued = { 0 };
+
+    /// Idle workers sleep on the condition variable, until the version changes (new transfer or released stream)
+    std::mutex idle_mtx;
+    std::condition_variable idle_cv;
+    uint64_t version = { 0 };
+    bool stop = { false };
+
+    /// Threads in drain() sleep on the condition variable, until all transfers have completed
+    std::condition_variable drain_cv;
+
+    /// Main loop of a worker
+    void run(uint32_t id);
+
+    /// Takes the first runnable transfer from the queue of the given worker and reserves its stream; returns false if there is none
+    bool take(uint32_t victim, cPoolTask &task);
+
+    /// Executes a transfer on the cThread of the given worker and releases its stream
+    void execute(uint32_t id, cPoolTask &task);
+
+    /// Wakes up one idle worker, after a transfer became runnable (a new transfer was queued or a stream was released)
+    void notify();
+
+public:
+    /**
+     * @brief Creates a pool of Coyote threads and starts the workers
+     *
+     * @param vfid Virtual FPGA ID
+     * @param n_workers Number of workers and cThreads
+     * @param n_streams Number of host streams of the vFPGA (N_STRM_AXI); if 0, the number of workers is used
+     * @param hpid Host process ID
+     * @param device Device number, for systems with multiple vFPGAs
+     */
+    cThreadPool(int32_t vfid, uint32_t n_workers, uint32_t n_streams = 0, pid_t hpid = getpid(), uint32_t device = 0);
+
+    /// Stops the workers, once all the queued transfers have completed, and releases the cThreads
+    ~cThreadPool();
+
+    cThreadPool(const cThreadPool&) = delete;
+    cThreadPool& operator=(const cThreadPool&) = delete;
+
+    /**
+     * @brief Allocates memory and maps it into all the cThreads of the pool
+     *
+     * @param alloc Allocation parameters, as for cThread::getMem
+     * @return Pointer to the allocated memory
+     */
+    void* getMem(CoyoteAlloc&& alloc);
+
+    /// Unmaps memory from all the cThreads of the pool and frees it; the memory must have been allocated with getMem()
+    void freeMem(void *vaddr);
+
+    /// Maps a buffer into all the cThreads of the pool, see cThread::userMap
+    void userMap(void *vaddr, uint32_t len);
+
+    /// Unmaps a buffer from all the cThreads of the pool, see cThread::userUnmap
+    void userUnmap(void *vaddr);
+
+    /**
+     * @brief Queues a one-sided local transfer (LOCAL_READ or LOCAL_WRITE)
+     *
+     * @param oper Operation to be invoked
+     * @param sg Scatter-gather entry; dest selects the host stream, or DEST_ANY
+     * @return Future, which is completed once the transfer has completed
+     */
+    cFuture invoke(CoyoteOper oper, localSg sg);
+
+    /**
+     * @brief Queues a local transfer (LOCAL_TRANSFER)
+     *
+     * @param oper Operation to be invoked
+     * @param src_sg Source scatter-gather entry
+     * @param dst_sg Destination scatter-gather entry; both entries must have the same dest, which selects the host stream, or DEST_ANY
+     * @return Future, which is completed once the transfer has completed
+     */
+    cFuture invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg);
+
+    /// Blocks until all the queued transfers have completed
+    void drain();
+
+    /// Returns the number of workers
+    uint32_t getNumWorkers() const;
+
+    /// Returns the cThread of the i-th worker, e.g., to set control registers
+    cThread* getThread(uint32_t i) const;
+
+    /// Returns the statistics of the pool
+    cThreadPoolStats getStats() const;
+};
+
+}
+
+#endif // _COYOTE_CTHREADPOOL_HPP_
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CTIMER_HPP_
+#define _COYOTE_CTIMER_HPP_
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace coyote {
+
+/// Duration over which the time-stamp counter is calibrated against the steady clock, in ms
+constexpr uint32_t const TIMER_CALIBRATION_MS = 20;
+
+/// Number of empty start()/stop() pairs timed, when measuring the overhead of the timer
+constexpr uint32_t const TIMER_OVERHEAD_SAMPLES = 10000;
+
+/**
+ * @brief Low-overhead timer, based on the CPU's time-stamp counter (TSC)
+ *
+ * Reading the TSC takes a few ns, compared to a few tens of ns for std::chrono clocks, which matters when timing 
+ * sub-microsecond operations, such as setCSR/getCSR. start() and stop() are serializing, so that the timed code 
+ * can't be reordered around them. The rate of the TSC is calibrated against the steady clock, once per process, 
+ * on the first call of any of the calibration-dependent functions (getTicksPerNs, toNs, getOverhead); at the same 
+ * time, warnings are printed if the timings may be unreliable: a non-invariant TSC (whose rate follows the CPU 
+ * frequency), or CPU frequency scaling (which doesn't affect an invariant TSC, but changes the timed code's duration).
+ *
+ * On other architectures, the timer falls back to the steady clock, with one tick per ns.
+ */
+class cTimer {
+
+public:
+    /// Returns the current timestamp, in ticks; not ordered with respect to the surrounding code (e.g., for tracing)
+    static inline uint64_t now() {
+        #if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+        #else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        #endif
+    }
+
+    /// Returns the timestamp at the start of a timed region; the region's code doesn't start before the counter is read
+    static inline uint64_t start() {
+        #if defined(__x86_64__) || defined(__i386__)
+        _mm_lfence();
+        uint64_t ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+        #else
+        return now();
+        #endif
+    }
+
+    /// Returns the timestamp at the end of a timed region; the counter isn't read before the region's code completes
+    static inline uint64_t stop() {
+        #if defined(__x86_64__) || defined(__i386__)
+        unsigned int aux;
+        uint64_t ticks = __rdtscp(&aux);
+        _mm_lfence();
+        return ticks;
+        #else
+        return now();
+        #endif
+    }
+
+    /// Returns the number of ticks per ns
+    static double getTicksPerNs();
+
+    /// Converts a number of ticks to ns
+    static double toNs(uint64_t ticks) { return (double) ticks / getTicksPerNs(); }
+
+    /// Returns the overhead of an empty timed region (a start() followed by a stop()), in ticks
+    static uint64_t getOverhead();
+
+    /// Returns true if the TSC is invariant, i.e., ticks at a constant rate regardless of the CPU frequency and power states
+    static bool isInvariant();
+};
+
+}
+
+#endif // _COYOTE_CTIMER_HPP_
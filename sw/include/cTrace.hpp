@@ -0,0 +1,221 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _COYOTE_CTRACE_HPP_
+#define _COYOTE_CTRACE_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+
+#include "cDefs.hpp"
+#include "cTimer.hpp"
+
+namespace coyote {
+
+/// Number of events per thread kept by the tracer; once full, the oldest events are overwritten (must be a power of two)
+constexpr uint32_t const TRACE_BUFFER_SIZE = 64 * 1024;
+
+/// Types of events, recorded by the tracer
+enum class cTraceEvent : uint32_t {
+    /// cThread::invoke; args: operation, completion token
+    INVOKE = 0,
+
+    /// Writing commands to the vFPGA; args: number of commands, bytes
+    POST_CMDS = 1,
+
+    /// Command submission stalled on a full command FIFO; args: none
+    STALL = 2,
+
+    /// Completion of an operation observed by the host (isCompleted, pollCompletions, the reactor); args: operation, token
+    COMPLETION = 3,
+
+    /// Blocking wait for completions (waitCompleted); args: operation, count
+    WAIT = 4,
+
+    /// Memory allocation (getMem) or release (freeMem); args: address, size
+    GET_MEM = 5,
+    FREE_MEM = 6,
+
+    /// Mapping or unmapping of a buffer in the vFPGA's TLB; args: address, size
+    USER_MAP = 7,
+    USER_UNMAP = 8,
+
+    /// Reconfiguration of the shell or an application; args: vFPGA ID (or -1 for the shell), bitstream size
+    RECONFIG = 9,
+
+    /// User interrupt handled; args: interrupt value
+    IRQ = 10
+};
+
+/// A single recorded event
+struct cTraceRecord {
+    /// Timestamps (see cTrace::timestamp); for instant events, end = begin
+    uint64_t begin = { 0 };
+    uint64_t end = { 0 };
+
+    /// Event type
+    cTraceEvent event = { cTraceEvent::INVOKE };
+
+    /// Coyote thread ID, or -1 if the event isn't tied to a cThread
+    int32_t ctid = { -1 };
+
+    /// Event-specific arguments, see cTraceEvent
+    uint64_t arg0 = { 0 };
+    uint64_t arg1 = { 0 };
+};
+
+/// Events of one software thread; written only by the owning thread
+struct cTraceBuffer {
+    /// OS thread ID of the owner
+    pid_t tid = { 0 };
+
+    /// Number of events ever recorded; the last min(head, TRACE_BUFFER_SIZE) events are in the ring
+    std::atomic<uint64_t> head = { 0 };
+
+    /// Ring of events
+    std::unique_ptr<cTraceRecord[]> records;
+};
+
+/**
+ * @brief Low-overhead event tracer for the host-side software of Coyote
+ *
+ * Every software thread records its events into its own ring buffer, without any locks or shared writes, 
+ * with timestamps from the CPU's time-stamp counter (see cTimer). The buffers are kept after the threads exit, 
+ * so that the trace can be exported at any point; e.g., as Chrome trace JSON, which can be opened in 
+ * chrome://tracing or https://ui.perfetto.dev to see how submission, DMA and completions of different 
+ * cThreads overlap on a timeline.
+ *
+ * Tracing is only compiled in with EN_TRACE (cmake -DEN_TRACE=1); otherwise, the TRACE_* macros expand 
+ * to nothing and their arguments aren't evaluated.
+ *
+ * @note The buffers are read without synchronizing with the writers; events recorded while exporting may be torn,
+ * so the trace should be exported once the traced operations have completed
+ */
+class cTrace {
+
+private:
+    /// Protects the list of buffers
+    std::mutex mtx;
+
+    /// Buffers of all the threads that recorded an event
+    std::vector<std::shared_ptr<cTraceBuffer>> buffers;
+
+    /// Recording can be disabled at run-time, e.g., to only trace a part of the application
+    std::atomic<bool> enabled = { true };
+
+    /// Timestamp at the creation of the tracer; the exported timestamps are relative to it
+    uint64_t base_tsc;
+
+    cTrace();
+
+    /// Returns the buffer of the calling thread, creating it on the first call
+    cTraceBuffer& getBuffer();
+
+public:
+    cTrace(const cTrace&) = delete;
+    cTrace& operator=(const cTrace&) = delete;
+
+    /// Returns the process-wide tracer
+    static cTrace& getInstance();
+
+    /// Returns the current timestamp, in CPU time-stamp counter ticks
+    static inline uint64_t timestamp() { return cTimer::now(); }
+
+    /// Records an event of the calling thread, which started at begin and ended at end
+    void record(cTraceEvent event, uint64_t begin, uint64_t end, int32_t ctid, uint64_t arg0 = 0, uint64_t arg1 = 0);
+
+    /// Enables or disables recording at run-time; enabled by default
+    void setEnabled(bool enable);
+
+    /// Discards all the recorded events
+    void clear();
+
+    /// Returns a copy of all the recorded events of all threads, in the order they were recorded per thread
+    std::vector<std::pair<pid_t, cTraceRecord>> getRecords();
+
+    /**
+     * @brief Writes the recorded events in the Chrome trace event format (JSON)
+     *
+     * Every software thread is shown as a separate track, with the events as (nested) slices. Additionally, the lifetime 
+     * of every operation, from invoke to the first observed completion, is shown as an asynchronous slice per cThread,
+     * making the overlap of the DMA with the host-side work visible. The format can also be imported by Perfetto.
+     */
+    void writeChrome(std::ostream &out);
+
+    /// Same as above, but writes the trace to a file
+    void writeChrome(const std::string &path);
+};
+
+/// Returns the name of an event, e.g., "invoke"
+const char* getTraceEventName(cTraceEvent event);
+
+/// Records an event spanning the lifetime of the object; for functions with many exit points
+class cTraceScope {
+
+private:
+    cTraceEvent event;
+    int32_t ctid;
+    uint64_t arg0, arg1;
+    uint64_t begin;
+
+public:
+    cTraceScope(cTraceEvent event, int32_t ctid, uint64_t arg0, uint64_t arg1) :
+        event(event), ctid(ctid), arg0(arg0), arg1(arg1), begin(cTrace::timestamp()) {}
+
+    ~cTraceScope() { cTrace::getInstance().record(event, begin, cTrace::timestamp(), ctid, arg0, arg1); }
+};
+
+}
+
+#ifdef EN_TRACE
+
+/// Declares a variable holding the start timestamp of an event
+#define TRACE_BEGIN(var) uint64_t var = coyote::cTrace::timestamp()
+
+/// Records an event that started at the timestamp in var and ends now
+#define TRACE_END(var, event, ctid, arg0, arg1) coyote::cTrace::getInstance().record(event, var, coyote::cTrace::timestamp(), ctid, arg0, arg1)
+
+/// Records an instant event
+#define TRACE_INSTANT(event, ctid, arg0, arg1) do { uint64_t trace_ts = coyote::cTrace::timestamp(); coyote::cTrace::getInstance().record(event, trace_ts, trace_ts, ctid, arg0, arg1); } while (0)
+
+/// Records an event from here until the end of the enclosing scope
+#define TRACE_SCOPE(event, ctid, arg0, arg1) coyote::cTraceScope trace_scope(event, ctid, arg0, arg1)
+
+#else
+
+#define TRACE_BEGIN(var)
+#define TRACE_END(var, event, ctid, arg0, arg1)
+#define TRACE_INSTANT(event, ctid, arg0, arg1)
+#define TRACE_SCOPE(event, ctid, arg0, arg1)
+
+#endif
+
+#endif // _COYOTE_CTRACE_HPP_
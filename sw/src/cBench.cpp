@@ -28,33 +28,218 @@
 
 namespace coyote {
 
-cBench::cBench(unsigned int n_runs, unsigned int n_warmups) { 
+/// Continued fraction of the regularized incomplete beta function, evaluated with the modified Lentz method
+static double betaContinuedFraction(double a, double b, double x) {
+    const int max_iters = 300;
+    const double eps = 1e-15;
+    const double min_val = 1e-300;
+
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    if (std::fabs(d) < min_val) { d = min_val; }
+    d = 1.0 / d;
+    double h = d;
+
+    for (int m = 1; m <= max_iters; m++) {
+        // Even step
+        double aa = m * (b - m) * x / ((a - 1.0 + 2 * m) * (a + 2 * m));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < min_val) { d = min_val; }
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < min_val) { c = min_val; }
+        d = 1.0 / d;
+        h *= d * c;
+
+        // Odd step
+        aa = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 1.0 + 2 * m));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < min_val) { d = min_val; }
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < min_val) { c = min_val; }
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+
+        if (std::fabs(delta - 1.0) < eps) { break; }
+    }
+
+    return h;
+}
+
+/// Regularized incomplete beta function I_x(a, b)
+static double incompleteBeta(double a, double b, double x) {
+    if (x <= 0.0) { return 0.0; }
+    if (x >= 1.0) { return 1.0; }
+
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * betaContinuedFraction(a, b, x) / a;
+    } else {
+        return 1.0 - front * betaContinuedFraction(b, a, 1.0 - x) / b;
+    }
+}
+
+double studentTCdf(double t, double dof) {
+    if (dof <= 0) { return NaN; }
+
+    double tail = 0.5 * incompleteBeta(dof / 2.0, 0.5, dof / (dof + t * t));
+    return t >= 0 ? 1.0 - tail : tail;
+}
+
+double studentTQuantile(double p, double dof) {
+    if (dof <= 0 || p <= 0.0 || p >= 1.0) { return NaN; }
+
+    // The distribution is symmetric, so only the upper half is searched
+    if (p < 0.5) { return -studentTQuantile(1.0 - p, dof); }
+
+    double lo = 0.0, hi = 1.0;
+    while (studentTCdf(hi, dof) < p) {
+        lo = hi;
+        hi *= 2.0;
+    }
+
+    for (int i = 0; i < 100; i++) {
+        double mid = 0.5 * (lo + hi);
+        if (studentTCdf(mid, dof) < p) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return 0.5 * (lo + hi);
+}
+
+double welchTTest(double mean_a, double std_dev_a, uint64_t n_a, double mean_b, double std_dev_b, uint64_t n_b) {
+    if (n_a < 2 || n_b < 2) { return NaN; }
+
+    double var_a = std_dev_a * std_dev_a / (double) n_a;
+    double var_b = std_dev_b * std_dev_b / (double) n_b;
+    if (var_a + var_b == 0) { 
+        return mean_a == mean_b ? 1.0 : 0.0; 
+    }
+
+    // Welch-Satterthwaite approximation of the degrees of freedom
+    double t = (mean_a - mean_b) / std::sqrt(var_a + var_b);
+    double dof = (var_a + var_b) * (var_a + var_b) / (var_a * var_a / (double) (n_a - 1) + var_b * var_b / (double) (n_b - 1));
+    return 2.0 * (1.0 - studentTCdf(std::fabs(t), dof));
+}
+
+cBench::cBench(unsigned int n_runs, unsigned int n_warmups, uint32_t precision): measured_times(precision) { 
     this->n_runs = n_runs; 
     this->n_warmups = n_warmups;
+
+    // Calibrates the timer (once per process), so that it doesn't happen during the first benchmark
+    this->timer_overhead = cTimer::getOverhead();
 } 
 
-double cBench::getAvg() { 
-    if(measured_times.empty()) { return NaN; }
-    
-    double avg_time = 0;
-    for (const double &t : measured_times) {
-        avg_time += t;
+void cBench::setWork(uint64_t n_bytes, uint64_t n_ops) {
+    this->n_bytes = n_bytes;
+    this->n_ops = n_ops;
+}
+
+double cBench::getAvg() const { return measured_times.getMean(); }
+
+double cBench::getMin() const { return measured_times.getMin(); }
+
+double cBench::getMax() const { return measured_times.getMax(); }
+
+double cBench::getP25() const { return measured_times.getPercentile(25); }
+
+double cBench::getP50() const { return measured_times.getPercentile(50); }
+
+double cBench::getP75() const { return measured_times.getPercentile(75); }
+
+double cBench::getP95() const { return measured_times.getPercentile(95); }
+
+double cBench::getP99() const { return measured_times.getPercentile(99); }
+
+double cBench::getPercentile(double percentile) const { return measured_times.getPercentile(percentile); }
+
+double cBench::getStdDev() const { return measured_times.getStdDev(); }
+
+const cHistogram& cBench::getHistogram() const { return measured_times; }
+
+void cBench::setPerfCounters(bool enable) {
+    perf_enabled = enable;
+}
+
+void cBench::clearResults() {
+    measured_times.clear();
+    run_times.clear();
+    thread_times.clear();
+    n_threads = 1;
+    perf_counts = cPerfCounts();
+    perf_iters = 0;
+}
+
+cBenchInterval cBench::getRate(const cHistogram &times, double work, double confidence) {
+    if(times.getCount() == 0) { 
+        double nan = NaN;
+        return { nan, nan, nan }; 
+    }
+
+    // Confidence interval of the mean time per iteration; with a single run, there's no estimate of the variance
+    double avg_time = times.getMean();
+    double half_width = 0;
+    if (times.getCount() > 1) {
+        double dof = (double) (times.getCount() - 1);
+        half_width = studentTQuantile(0.5 + confidence / 2.0, dof) * times.getStdDev() / std::sqrt((double) times.getCount());
     }
-    return avg_time / (double) measured_times.size(); 
+
+    // Times are in ns; a shorter time corresponds to a higher rate, so the bounds are swapped
+    double rate = work * 1e9 / avg_time;
+    double lo = work * 1e9 / (avg_time + half_width);
+    double hi = avg_time > half_width ? work * 1e9 / (avg_time - half_width) : std::numeric_limits<double>::infinity();
+    return { rate, lo, hi };
 }
 
-double cBench::getMin() { if(!measured_times.empty()) return measured_times[0]; else return NaN; }
+// In a multi-threaded benchmark, all the threads complete their work within the wall-clock time of a run
+cBenchInterval cBench::getOpsPerSec(double confidence) const { 
+    if (n_threads > 1) {
+        return getRate(run_times, (double) n_ops * n_threads, confidence);
+    }
+    return getRate(measured_times, (double) n_ops, confidence); 
+}
 
-double cBench::getMax() { if(!measured_times.empty()) return measured_times[measured_times.size()-1]; else return NaN; }
+cBenchInterval cBench::getBytesPerSec(double confidence) const { 
+    if (n_threads > 1) {
+        return getRate(run_times, (double) n_bytes * n_threads, confidence);
+    }
+    return getRate(measured_times, (double) n_bytes, confidence); 
+}
 
-double cBench::getP25() { if(!measured_times.empty()) return measured_times[(measured_times.size()/4)-1]; else return NaN; }
+cBenchInterval cBench::getGBPerSec(double confidence) const { 
+    cBenchInterval rate = getBytesPerSec(confidence);
+    return { rate.avg / 1e9, rate.lo / 1e9, rate.hi / 1e9 };
+}
 
-double cBench::getP50() { if(!measured_times.empty()) return measured_times[(measured_times.size()/2)-1]; else return NaN; }
+double cBench::getPerfCounter(cPerfEvent event) const {
+    if (perf_iters == 0 || !perf_counts.isAvailable(event)) {
+        return NaN;
+    }
+    return perf_counts.get(event) / (double) perf_iters;
+}
 
-double cBench::getP75() { if(!measured_times.empty()) return measured_times[((measured_times.size()*3)/4)-1]; else return NaN; }
+const cPerfCounts& cBench::getPerfCounts() const { return perf_counts; }
 
-double cBench::getP95() { if(!measured_times.empty()) return measured_times[((measured_times.size()*95)/100)-1]; else return NaN; }
+double cBench::getTimerOverhead() const { return cTimer::toNs(timer_overhead); }
 
-double cBench::getP99() { if(!measured_times.empty()) return measured_times[((measured_times.size()*99)/100)-1]; else return NaN; }
+unsigned int cBench::getNumThreads() const { return n_threads; }
+
+const cHistogram& cBench::getThreadHistogram(unsigned int tid) const {
+    if (tid >= thread_times.size()) {
+        throw std::runtime_error("ERROR: cBench::getThreadHistogram() - no results for thread " + std::to_string(tid));
+    }
+    return thread_times[tid];
+}
+
+cBenchInterval cBench::getThreadOpsPerSec(unsigned int tid, double confidence) const { 
+    return getRate(getThreadHistogram(tid), (double) n_ops, confidence); 
+}
+
+cBenchInterval cBench::getThreadBytesPerSec(unsigned int tid, double confidence) const { 
+    return getRate(getThreadHistogram(tid), (double) n_bytes, confidence); 
+}
 
 }
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#include "cBufferPool.hpp"
+#include "cThread.hpp"
+
+namespace coyote {
+
+/// Source of unique pool IDs; IDs are never reused, so stale thread-local caches of destroyed pools are never accessed
+static std::atomic<uint64_t> next_pool_id = { 1 };
+
+/// Pools that haven't been destroyed yet, keyed by their ID; lets threads return their cached buffers on exit
+static std::mutex registry_mtx;
+static std::unordered_map<uint64_t, cBufferPool*> registry;
+
+/// Number of destroyed pools; when it changes, threads drop their caches of destroyed pools (see getCache)
+static std::atomic<uint64_t> n_destroyed_pools = { 0 };
+
+/// Thread-local caches of free buffers, for every pool used by a thread, keyed by the pool ID
+struct cThreadCaches {
+    std::unordered_map<uint64_t, std::array<std::vector<void*>, BPOOL_N_CLASSES>> caches;
+
+    /// Number of destroyed pools, when the caches of destroyed pools were last dropped
+    uint64_t n_destroyed = { 0 };
+
+    /// On thread exit, returns the cached buffers to the pools that still exist, so they can be handed out again
+    ~cThreadCaches() {
+        std::lock_guard<std::mutex> lock(registry_mtx);
+        for (auto &it : caches) {
+            auto pool = registry.find(it.first);
+            if (pool != registry.end()) {
+                pool->second->returnCache(it.second.data());
+            }
+        }
+    }
+};
+static thread_local cThreadCaches tl_caches;
+
+/// The most recently used thread-local cache, to avoid the hash map lookup on every allocation
+static thread_local uint64_t tl_last_id = 0;
+static thread_local std::vector<void*> *tl_last_cache = nullptr;
+
+cBufferPool::cBufferPool(cThread &thread, uint32_t region_size, CoyoteAllocType alloc_type) : 
+    pool_id(next_pool_id.fetch_add(1)), thread(thread), alloc_type(alloc_type), region_size(region_size), 
+    regions(new cRegion[BPOOL_MAX_REGIONS]) {
+    DBG1("cBufferPool: Creating pool " << pool_id << " with region size " << region_size);
+
+    if (region_size == 0 || region_size % BPOOL_SLAB_SIZE) {
+        throw std::runtime_error("ERROR: cBufferPool - region size must be a non-zero multiple of 2 MB, exiting...");
+    }
+
+    if (alloc_type != CoyoteAllocType::HPF && alloc_type != CoyoteAllocType::THP) {
+        throw std::runtime_error("ERROR: cBufferPool - regions can only be allocated as HPF or THP memory, exiting...");
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mtx);
+    registry[pool_id] = this;
+}
+
+cBufferPool::~cBufferPool() {
+    DBG1("cBufferPool: Destroying pool " << pool_id);
+
+    // Unregistered first, so that exiting threads no longer return buffers to the pool; a thread returning its buffers 
+    // right now holds the registry lock, so the pool is only destroyed once it's done
+    {
+        std::lock_guard<std::mutex> registry_lock(registry_mtx);
+        registry.erase(pool_id);
+        n_destroyed_pools.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (uint32_t i = 0; i < n_regions.load(); i++) {
+        thread.freeMem(regions[i].base);
+    }
+
+    for (auto &it : large_allocs) {
+        thread.freeMem(it.first);
+    }
+    large_allocs.clear();
+
+    // The caches of other threads are dropped the next time they look up a cache (see getCache) or exit
+    tl_caches.caches.erase(pool_id);
+    if (tl_last_id == pool_id) {
+        tl_last_id = 0;
+        tl_last_cache = nullptr;
+    }
+}
+
+uint32_t cBufferPool::getClass(size_t size) {
+    if (size <= (1 << BPOOL_MIN_SHIFT)) {
+        return 0;
+    }
+    return (64 - __builtin_clzll(size - 1)) - BPOOL_MIN_SHIFT;
+}
+
+std::vector<void*>* cBufferPool::getCache() {
+    if (tl_last_id != pool_id) {
+        // Drop the caches of destroyed pools; their buffers were released with the pools
+        uint64_t n_destroyed = n_destroyed_pools.load(std::memory_order_relaxed);
+        if (n_destroyed != tl_caches.n_destroyed) {
+            std::lock_guard<std::mutex> lock(registry_mtx);
+            for (auto it = tl_caches.caches.begin(); it != tl_caches.caches.end();) {
+                it = registry.count(it->first) ? std::next(it) : tl_caches.caches.erase(it);
+            }
+            tl_caches.n_destroyed = n_destroyed;
+        }
+
+        tl_last_cache = tl_caches.caches[pool_id].data();
+        tl_last_id = pool_id;
+    }
+    return tl_last_cache;
+}
+
+void cBufferPool::returnCache(std::vector<void*> *cache) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (uint32_t cls = 0; cls < BPOOL_N_CLASSES; cls++) {
+        free_lists[cls].insert(free_lists[cls].end(), cache[cls].begin(), cache[cls].end());
+        cache[cls].clear();
+    }
+    stats.n_flushes++;
+}
+
+void cBufferPool::flushThreadCache() {
+    auto it = tl_caches.caches.find(pool_id);
+    if (it != tl_caches.caches.end()) {
+        returnCache(it->second.data());
+    }
+}
+
+cBufferPool::cRegion& cBufferPool::reserveRegion() {
+    uint32_t idx = n_regions.load(std::memory_order_relaxed);
+    if (idx == BPOOL_MAX_REGIONS) {
+        throw std::runtime_error("ERROR: cBufferPool - maximum number of regions reached, exiting...");
+    }
+
+    void *mem = thread.getMem({alloc_type, region_size});
+    if (mem == nullptr || mem == MAP_FAILED) {
+        throw std::runtime_error("ERROR: cBufferPool - failed to reserve a new region, exiting...");
+    }
+    DBG1("cBufferPool: Reserved region " << idx << " at " << mem);
+
+    cRegion &region = regions[idx];
+    region.base = static_cast<char *>(mem);
+    region.slab_class.assign(region_size / BPOOL_SLAB_SIZE, -1);
+    region.n_carved = 0;
+    n_regions.store(idx + 1, std::memory_order_release);
+
+    stats.n_regions++;
+    stats.reserved_bytes += region_size;
+    return region;
+}
+
+void cBufferPool::carveSlab(uint32_t cls) {
+    // Slabs are carved in order, so only the regions from curr_region onwards can have free slabs
+    uint32_t n_slabs = region_size / BPOOL_SLAB_SIZE;
+    while (curr_region < n_regions.load(std::memory_order_relaxed) && regions[curr_region].n_carved == n_slabs) {
+        curr_region++;
+    }
+    cRegion &region = curr_region < n_regions.load(std::memory_order_relaxed) ? regions[curr_region] : reserveRegion();
+
+    uint32_t slab = region.n_carved++;
+    region.slab_class[slab] = static_cast<int8_t>(cls);
+    stats.n_slabs++;
+
+    // Add the buffers in reverse order, so that they are handed out in increasing address order
+    char *slab_base = region.base + static_cast<uint64_t>(slab) * BPOOL_SLAB_SIZE;
+    uint32_t buf_size = 1 << (cls + BPOOL_MIN_SHIFT);
+    for (int64_t offs = BPOOL_SLAB_SIZE - buf_size; offs >= 0; offs -= buf_size) {
+        free_lists[cls].push_back(slab_base + offs);
+    }
+}
+
+cBufferPool::cRegion* cBufferPool::findRegion(const void *ptr) const {
+    const char *p = static_cast<const char *>(ptr);
+    uint32_t n = n_regions.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; i++) {
+        if (p >= regions[i].base && p < regions[i].base + region_size) {
+            return &regions[i];
+        }
+    }
+    return nullptr;
+}
+
+void cBufferPool::reserve(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mtx);
+    while (stats.reserved_bytes < bytes) {
+        reserveRegion();
+    }
+}
+
+void* cBufferPool::alloc(size_t size) {
+    // Large allocations are passed through to the cThread
+    if (size > BPOOL_SLAB_SIZE) {
+        if (size > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("ERROR: cBufferPool - buffers larger than 4 GB can't be allocated, exiting...");
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        void *mem = thread.getMem({alloc_type, static_cast<uint32_t>(size)});
+        if (mem == nullptr || mem == MAP_FAILED) {
+            throw std::runtime_error("ERROR: cBufferPool - failed to allocate a large buffer, exiting...");
+        }
+        large_allocs[mem] = size;
+        stats.n_large++;
+        return mem;
+    }
+
+    // Fast path: a free buffer from the thread-local cache
+    uint32_t cls = getClass(size);
+    std::vector<void*> &cache = getCache()[cls];
+    if (cache.empty()) {
+        // Refill half of the cache from the shared free list, carving a new slab if needed
+        std::lock_guard<std::mutex> lock(mtx);
+        if (free_lists[cls].empty()) {
+            carveSlab(cls);
+        }
+
+        std::vector<void*> &free_list = free_lists[cls];
+        size_t n_refill = std::min(free_list.size(), static_cast<size_t>(BPOOL_CACHE_SIZE / 2));
+        cache.insert(cache.end(), free_list.end() - n_refill, free_list.end());
+        free_list.resize(free_list.size() - n_refill);
+        stats.n_refills++;
+    }
+
+    void *mem = cache.back();
+    cache.pop_back();
+    return mem;
+}
+
+void cBufferPool::free(void *ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    cRegion *region = findRegion(ptr);
+    if (region) {
+        // Fast path: return the buffer to the thread-local cache
+        uint32_t cls = region->slab_class[(static_cast<char *>(ptr) - region->base) >> BPOOL_SLAB_SHIFT];
+        std::vector<void*> &cache = getCache()[cls];
+        cache.push_back(ptr);
+
+        // Once the cache is full, return half of it to the shared free list
+        if (cache.size() > BPOOL_CACHE_SIZE) {
+            std::lock_guard<std::mutex> lock(mtx);
+            size_t n_flush = cache.size() / 2;
+            free_lists[cls].insert(free_lists[cls].end(), cache.begin(), cache.begin() + n_flush);
+            cache.erase(cache.begin(), cache.begin() + n_flush);
+            stats.n_flushes++;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = large_allocs.find(ptr);
+        if (it == large_allocs.end()) {
+            throw std::runtime_error("ERROR: cBufferPool::free() called with a pointer that wasn't allocated from the pool, exiting...");
+        }
+        thread.freeMem(ptr);
+        large_allocs.erase(it);
+    }
+}
+
+size_t cBufferPool::getSize(const void *ptr) {
+    cRegion *region = findRegion(ptr);
+    if (region) {
+        uint32_t cls = region->slab_class[(static_cast<const char *>(ptr) - region->base) >> BPOOL_SLAB_SHIFT];
+        return static_cast<size_t>(1) << (cls + BPOOL_MIN_SHIFT);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = large_allocs.find(const_cast<void *>(ptr));
+    return it == large_allocs.end() ? 0 : it->second;
+}
+
+bool cBufferPool::owns(const void *ptr) {
+    if (findRegion(ptr)) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    return large_allocs.count(const_cast<void *>(ptr)) > 0;
+}
+
+cBufferPoolStats cBufferPool::getStats() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+
+}
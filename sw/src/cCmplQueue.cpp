@@ -0,0 +1,161 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdexcept>
+
+#include "cCmplQueue.hpp"
+
+namespace coyote {
+
+int32_t cCmplQueue::getClass(CoyoteOper oper) {
+    // Same order as in cThread::checkCompleted; LOCAL_TRANSFER is completed once its write is completed
+    if (isLocalWrite(oper)) {
+        return WR_WBACK;
+    } else if (isLocalRead(oper)) {
+        return RD_WBACK;
+    } else if (isRemoteRead(oper)) {
+        return RD_RDMA_WBACK;
+    } else if (isRemoteWriteOrSend(oper)) {
+        return WR_RDMA_WBACK;
+    } else {
+        return -1;
+    }
+}
+
+CoyoteOper cCmplQueue::getClassOper(uint32_t cls) {
+    switch (cls) {
+        case RD_WBACK: return CoyoteOper::LOCAL_READ;
+        case WR_WBACK: return CoyoteOper::LOCAL_WRITE;
+        case RD_RDMA_WBACK: return CoyoteOper::REMOTE_RDMA_READ;
+        case WR_RDMA_WBACK: return CoyoteOper::REMOTE_RDMA_WRITE;
+        default: return CoyoteOper::NOOP;
+    }
+}
+
+int32_t cCmplQueue::getTokenClass(cmplToken token) {
+    if (token == CMPL_TOKEN_NONE) {
+        return -1;
+    }
+    return static_cast<int32_t>(token >> (64 - CMPL_CLASS_BITS)) - 1;
+}
+
+cmplToken cCmplQueue::issue(CoyoteOper oper, bool last) {
+    int32_t cls = getClass(oper);
+    if (cls < 0) {
+        return CMPL_TOKEN_NONE;
+    }
+
+    // Checked before any state is modified, so that a refused command doesn't shift the sequence numbers
+    if (last && tracking && pending_tail[cls] - pending_head[cls] == CMPL_QUEUE_DEPTH) {
+        throw std::runtime_error(
+            "ERROR: cCmplQueue::issue() - completion queue full; poll the completions before issuing more than " + 
+            std::to_string(CMPL_QUEUE_DEPTH) + " operations of a class"
+        );
+    }
+
+    // The source of a LOCAL_TRANSFER also increments the read counter, so keep the read sequence in step with it
+    if (oper == CoyoteOper::LOCAL_TRANSFER && last) {
+        issued[RD_WBACK]++;
+    }
+
+    uint64_t seq = last ? ++issued[cls] : issued[cls] + 1;
+    cmplToken token = (static_cast<uint64_t>(cls + 1) << (64 - CMPL_CLASS_BITS)) | (seq & CMPL_SEQ_MASK);
+
+    if (last && tracking) {
+        pending[cls][pending_tail[cls]++ & (CMPL_QUEUE_DEPTH - 1)] = { .token = token, .oper = oper };
+    }
+
+    return token;
+}
+
+void cCmplQueue::update(uint32_t cls, uint32_t cnt) {
+    // Unsigned difference handles the wrap-around of the 32-bit hardware counter
+    completed[cls] += static_cast<uint32_t>(cnt - hw_cnt[cls]);
+    hw_cnt[cls] = cnt;
+}
+
+bool cCmplQueue::hasPending(uint32_t cls) const { return pending_tail[cls] != pending_head[cls]; }
+
+bool cCmplQueue::isCompleted(cmplToken token) const {
+    int32_t cls = getTokenClass(token);
+    if (cls < 0) {
+        return true;
+    }
+
+    // Wrap-safe comparison of the completed count and the sequence number, in the sequence number space
+    uint64_t diff = (completed[cls] - (token & CMPL_SEQ_MASK)) & CMPL_SEQ_MASK;
+    return (diff >> (63 - CMPL_CLASS_BITS)) == 0;
+}
+
+bool cCmplQueue::isCompleted(cmplToken token, uint32_t cnt) {
+    if (token == CMPL_TOKEN_NONE) {
+        return true;
+    }
+
+    // Wrap-safe comparison of the 32-bit counter and the lower 32 bits of the sequence number
+    return static_cast<int32_t>(cnt - static_cast<uint32_t>(token & CMPL_SEQ_MASK)) >= 0;
+}
+
+uint32_t cCmplQueue::poll(cmplEntry *cmpls, uint32_t n_cmpls) {
+    uint32_t n_polled = 0;
+    for (uint32_t cls = 0; cls < N_WBACKS; cls++) {
+        while (n_polled < n_cmpls && hasPending(cls) && isCompleted(pending[cls][pending_head[cls] & (CMPL_QUEUE_DEPTH - 1)].token)) {
+            cmpls[n_polled++] = pending[cls][pending_head[cls]++ & (CMPL_QUEUE_DEPTH - 1)];
+        }
+    }
+    return n_polled;
+}
+
+void cCmplQueue::clear() {
+    for (uint32_t cls = 0; cls < N_WBACKS; cls++) {
+        issued[cls] = 0;
+        completed[cls] = 0;
+        hw_cnt[cls] = 0;
+        pending_head[cls] = 0;
+        pending_tail[cls] = 0;
+    }
+}
+
+void cCmplQueue::setTracking(bool enable) {
+    if (enable == tracking) {
+        return;
+    }
+
+    for (uint32_t cls = 0; cls < N_WBACKS; cls++) {
+        if (enable && !pending[cls]) {
+            pending[cls].reset(new cmplEntry[CMPL_QUEUE_DEPTH]);
+        } else if (!enable) {
+            pending[cls].reset();
+        }
+        pending_head[cls] = 0;
+        pending_tail[cls] = 0;
+    }
+    tracking = enable;
+}
+
+bool cCmplQueue::isTracking() const { return tracking; }
+
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cFuture.hpp"
+
+namespace coyote {
+
+cFuture::cFuture(std::shared_ptr<cFutureState> state) : state(std::move(state)) {}
+
+bool cFuture::valid() const { return state != nullptr; }
+
+bool cFuture::ready() const {
+    if (!state) {
+        throw std::runtime_error("ERROR: cFuture::ready() called on an invalid future, exiting...");
+    }
+
+    std::lock_guard<std::mutex> lock(state->mtx);
+    return state->ready;
+}
+
+void cFuture::wait() const {
+    if (!state) {
+        throw std::runtime_error("ERROR: cFuture::wait() called on an invalid future, exiting...");
+    }
+
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->cv.wait(lock, [&] { return state->ready; });
+    if (state->exc) {
+        std::rethrow_exception(state->exc);
+    }
+}
+
+bool cFuture::wait_for(std::chrono::nanoseconds timeout) const {
+    if (!state) {
+        throw std::runtime_error("ERROR: cFuture::wait_for() called on an invalid future, exiting...");
+    }
+
+    std::unique_lock<std::mutex> lock(state->mtx);
+    return state->cv.wait_for(lock, timeout, [&] { return state->ready; });
+}
+
+cFuture cFuture::then(std::function<void()> func) const {
+    if (!state) {
+        throw std::runtime_error("ERROR: cFuture::then() called on an invalid future, exiting...");
+    }
+
+    cPromise next(state->token);
+    std::shared_ptr<cFutureState> prev = state;
+    auto callback = [prev, next, func = std::move(func)]() {
+        // The previous state is already completed once the callback is called, so the error can be read without the lock
+        if (prev->exc) {
+            next.setException(prev->exc);
+            return;
+        }
+
+        try {
+            func();
+            next.setReady();
+        } catch (...) {
+            next.setException(std::current_exception());
+        }
+    };
+
+    std::unique_lock<std::mutex> lock(state->mtx);
+    if (state->ready) {
+        lock.unlock();
+        callback();
+    } else {
+        state->callbacks.emplace_back(std::move(callback));
+    }
+
+    return next.getFuture();
+}
+
+cmplToken cFuture::getToken() const { return state ? state->token : CMPL_TOKEN_NONE; }
+
+cPromise::cPromise(cmplToken token) : state(std::make_shared<cFutureState>()) {
+    state->token = token;
+}
+
+cFuture cPromise::getFuture() const { return cFuture(state); }
+
+void cPromise::setReady() const {
+    setException(nullptr);
+}
+
+void cPromise::setException(std::exception_ptr exc) const {
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        if (state->ready) {
+            throw std::runtime_error("ERROR: cPromise - operation completed more than once, exiting...");
+        }
+        state->ready = true;
+        state->exc = exc;
+        callbacks.swap(state->callbacks);
+    }
+    state->cv.notify_all();
+
+    // Continuations are executed without holding the lock, since they may chain further continuations
+    for (auto &callback : callbacks) {
+        callback();
+    }
+}
+
+}
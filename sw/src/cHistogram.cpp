@@ -0,0 +1,211 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "cHistogram.hpp"
+
+namespace coyote {
+
+cHistogram::cHistogram(uint32_t precision): precision(precision) {
+    if (precision < 1 || precision > HIST_MAX_PRECISION) {
+        throw std::runtime_error("ERROR: cHistogram - precision must be between 1 and " + std::to_string(HIST_MAX_PRECISION) + " bits");
+    }
+
+    // 2^precision exactly counted values, followed by 2^(precision - 1) buckets for every remaining power of two
+    counts.resize((1ULL << precision) + (64 - precision) * (1ULL << (precision - 1)), 0);
+}
+
+uint32_t cHistogram::getBucket(uint64_t value) const {
+    if (value < (1ULL << precision)) {
+        return (uint32_t) value;
+    }
+
+    // Only the most significant bits of the value are kept; the top bit is always set, so it's not part of the index
+    uint32_t msb = 63 - __builtin_clzll(value);
+    uint32_t shift = msb - precision + 1;
+    uint64_t sub = (value >> shift) - (1ULL << (precision - 1));
+    return (uint32_t) ((1ULL << precision) + (shift - 1) * (1ULL << (precision - 1)) + sub);
+}
+
+void cHistogram::getBucketRange(uint32_t bucket, uint64_t &lo, uint64_t &hi) const {
+    if (bucket < (1ULL << precision)) {
+        lo = bucket;
+        hi = bucket;
+        return;
+    }
+
+    uint64_t offs = bucket - (1ULL << precision);
+    uint32_t shift = (uint32_t) (offs >> (precision - 1)) + 1;
+    uint64_t sub = (offs & ((1ULL << (precision - 1)) - 1)) + (1ULL << (precision - 1));
+    lo = sub << shift;
+    hi = lo + ((1ULL << shift) - 1);
+}
+
+void cHistogram::record(uint64_t value, uint64_t n) {
+    if (n == 0) {
+        return;
+    }
+
+    counts[getBucket(value)] += n;
+    min_value = std::min(min_value, value);
+    max_value = std::max(max_value, value);
+
+    // Welford's update, for n identical values at once
+    uint64_t new_count = count + n;
+    double delta = (double) value - mean;
+    mean += delta * (double) n / (double) new_count;
+    m2 += delta * delta * (double) count * (double) n / (double) new_count;
+    count = new_count;
+}
+
+void cHistogram::merge(const cHistogram &other) {
+    if (other.precision != precision) {
+        throw std::runtime_error("ERROR: cHistogram::merge() - histograms must have the same precision");
+    }
+
+    if (other.count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+
+    // Parallel variant of Welford's algorithm (Chan et al.)
+    uint64_t new_count = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * (double) other.count / (double) new_count;
+    m2 += other.m2 + delta * delta * (double) count * (double) other.count / (double) new_count;
+    count = new_count;
+}
+
+void cHistogram::clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    count = 0;
+    min_value = UINT64_MAX;
+    max_value = 0;
+    mean = 0;
+    m2 = 0;
+}
+
+uint32_t cHistogram::getPrecision() const { return precision; }
+
+uint64_t cHistogram::getCount() const { return count; }
+
+double cHistogram::getMin() const { if (count) return (double) min_value; else return NaN; }
+
+double cHistogram::getMax() const { if (count) return (double) max_value; else return NaN; }
+
+double cHistogram::getMean() const { if (count) return mean; else return NaN; }
+
+double cHistogram::getStdDev() const { if (count > 1) return std::sqrt(m2 / (double) (count - 1)); else return NaN; }
+
+double cHistogram::getPercentile(double percentile) const {
+    if (count == 0) { 
+        return NaN; 
+    }
+
+    // Number of values at or below the percentile; at least one, so that P0 is the minimum
+    double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t target = std::max((uint64_t) std::ceil(clamped / 100.0 * (double) count), (uint64_t) 1);
+    if (target >= count) {
+        return (double) max_value;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            uint64_t lo, hi;
+            getBucketRange(i, lo, hi);
+            double mid = (double) lo + (double) (hi - lo) / 2.0;
+            return std::min(std::max(mid, (double) min_value), (double) max_value);
+        }
+    }
+
+    return (double) max_value;
+}
+
+std::string cHistogram::serialize() const {
+    std::ostringstream out;
+    out << "HIST1 " << precision << " " << count << " " << min_value << " " << max_value << " ";
+    out << std::setprecision(17) << mean << " " << m2;
+
+    for (uint32_t i = 0; i < counts.size(); i++) {
+        if (counts[i]) {
+            out << " " << i << ":" << counts[i];
+        }
+    }
+
+    return out.str();
+}
+
+cHistogram cHistogram::deserialize(const std::string &str) {
+    std::istringstream in(str);
+    std::string magic;
+    uint32_t precision;
+    in >> magic >> precision;
+    if (!in || magic != "HIST1") {
+        throw std::runtime_error("ERROR: cHistogram::deserialize() - not a serialized histogram");
+    }
+
+    cHistogram hist(precision);
+    in >> hist.count >> hist.min_value >> hist.max_value >> hist.mean >> hist.m2;
+    if (!in) {
+        throw std::runtime_error("ERROR: cHistogram::deserialize() - incomplete histogram");
+    }
+
+    uint64_t n_bucketed = 0;
+    std::string entry;
+    while (in >> entry) {
+        size_t sep = entry.find(':');
+        if (sep == std::string::npos) {
+            throw std::runtime_error("ERROR: cHistogram::deserialize() - malformed bucket " + entry);
+        }
+
+        uint64_t bucket = std::stoull(entry.substr(0, sep));
+        if (bucket >= hist.counts.size()) {
+            throw std::runtime_error("ERROR: cHistogram::deserialize() - bucket out of range " + entry);
+        }
+        hist.counts[bucket] = std::stoull(entry.substr(sep + 1));
+        n_bucketed += hist.counts[bucket];
+    }
+
+    if (n_bucketed != hist.count) {
+        throw std::runtime_error("ERROR: cHistogram::deserialize() - bucket counts don't match the number of values");
+    }
+
+    return hist;
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <new>
+#include <algorithm>
+#include <limits>
+
+#include "cMemResource.hpp"
+
+namespace coyote {
+
+cMemResource::cMemResource(cThread &thread, CoyoteAllocType alloc_type, uint32_t region_size) : 
+    pool(thread, region_size, alloc_type) {}
+
+void* cMemResource::do_allocate(size_t bytes, size_t alignment) {
+    // Pooled buffers are aligned to their size class, so over-aligned requests are served from a large enough size class;
+    // larger buffers are obtained from getMem, which aligns them to a huge page
+    if (alignment > BPOOL_SLAB_SIZE || bytes > std::numeric_limits<uint32_t>::max()) {
+        throw std::bad_alloc();
+    }
+
+    size_t size = bytes > BPOOL_SLAB_SIZE ? bytes : std::max(bytes, alignment);
+    try {
+        return pool.alloc(size);
+    } catch (const std::runtime_error &e) {
+        DBG1("cMemResource: Failed to allocate " << bytes << " bytes: " << e.what());
+        throw std::bad_alloc();
+    }
+}
+
+void cMemResource::do_deallocate(void *ptr, size_t, size_t) {
+    pool.free(ptr);
+}
+
+bool cMemResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+}
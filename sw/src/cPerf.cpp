@@ -0,0 +1,175 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <cstring>
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "cPerf.hpp"
+
+namespace coyote {
+
+/// Events for which a warning was already printed, as a bit mask indexed by cPerfEvent; so, every warning is only printed once per process
+static std::atomic<uint32_t> warned_events = { 0 };
+
+const char* getPerfEventName(cPerfEvent event) {
+    switch (event) {
+        case cPerfEvent::CYCLES: return "cycles";
+        case cPerfEvent::INSTRUCTIONS: return "instructions";
+        case cPerfEvent::LLC_MISSES: return "LLC misses";
+        case cPerfEvent::DTLB_MISSES: return "dTLB misses";
+        case cPerfEvent::CONTEXT_SWITCHES: return "context switches";
+        default: return "unknown";
+    }
+}
+
+cPerfCounts& cPerfCounts::operator+=(const cPerfCounts &other) {
+    for (uint32_t i = 0; i < N_PERF_EVENTS; i++) {
+        values[i] += other.values[i];
+        available[i] = available[i] || other.available[i];
+    }
+    return *this;
+}
+
+/// Sets the type and configuration of an event, as expected by perf_event_open
+static void setPerfEventConfig(cPerfEvent event, struct perf_event_attr &attr) {
+    auto cache_event = [](uint64_t cache, uint64_t op, uint64_t result) { return cache | (op << 8) | (result << 16); };
+
+    switch (event) {
+        case cPerfEvent::CYCLES:
+            attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case cPerfEvent::INSTRUCTIONS:
+            attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case cPerfEvent::LLC_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE; attr.config = cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS); break;
+        case cPerfEvent::DTLB_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE; attr.config = cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS); break;
+        case cPerfEvent::CONTEXT_SWITCHES:
+            attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES; break;
+        default:
+            throw std::runtime_error("ERROR: cPerf - unknown event");
+    }
+}
+
+cPerf::cPerf() {
+    for (uint32_t i = 0; i < N_PERF_EVENTS; i++) {
+        cPerfEvent event = static_cast<cPerfEvent>(i);
+
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        setPerfEventConfig(event, attr);
+        attr.disabled = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Context switches are only visible in the kernel; all the other events are counted in user space, 
+        // which doesn't include the system calls for enabling and disabling the counters and needs fewer permissions
+        attr.exclude_kernel = event != cPerfEvent::CONTEXT_SWITCHES;
+
+        // Calling thread (pid = 0), on any CPU (cpu = -1), without a group
+        fds[i] = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fds[i] == -1 && !(warned_events.fetch_or(1u << i) & (1u << i))) {
+            std::cerr << "WARNING: cPerf - could not open the counter of " << getPerfEventName(event) << ": " << strerror(errno);
+            if (errno == EACCES || errno == EPERM) {
+                std::cerr << " (perf_event_paranoid = " << getParanoidLevel() << "; " 
+                          << (attr.exclude_kernel ? "at most 2" : "at most 1") << " is needed for unprivileged users)";
+            }
+            std::cerr << std::endl;
+        }
+    }
+}
+
+cPerf::~cPerf() {
+    for (int fd : fds) {
+        if (fd != -1) { close(fd); }
+    }
+}
+
+bool cPerf::isAvailable(cPerfEvent event) const {
+    return fds[static_cast<uint32_t>(event)] != -1;
+}
+
+void cPerf::enable() {
+    for (int fd : fds) {
+        if (fd != -1) { ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+    }
+}
+
+void cPerf::disable() {
+    for (int fd : fds) {
+        if (fd != -1) { ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); }
+    }
+}
+
+void cPerf::reset() {
+    for (int fd : fds) {
+        if (fd != -1) { ioctl(fd, PERF_EVENT_IOC_RESET, 0); }
+    }
+}
+
+cPerfCounts cPerf::read() const {
+    cPerfCounts counts;
+    for (uint32_t i = 0; i < N_PERF_EVENTS; i++) {
+        if (fds[i] == -1) {
+            continue;
+        }
+
+        // Value, time enabled and time running; if there are more events than hardware counters, 
+        // the kernel multiplexes them, and the count is extrapolated to the entire time the counter was enabled
+        uint64_t data[3];
+        if (::read(fds[i], data, sizeof(data)) != sizeof(data)) {
+            continue;
+        }
+
+        // A counter that was enabled, but never scheduled (e.g., all the hardware counters are taken), has no meaningful count
+        if (data[1] > 0 && data[2] == 0) {
+            continue;
+        }
+        counts.available[i] = true;
+        counts.values[i] = data[2] ? (double) data[0] * (double) data[1] / (double) data[2] : 0.0;
+    }
+    return counts;
+}
+
+int32_t cPerf::getParanoidLevel() {
+    std::ifstream file("/proc/sys/kernel/perf_event_paranoid");
+    int32_t level;
+    if (!(file >> level)) {
+        return INT32_MAX;
+    }
+    return level;
+}
+
+}
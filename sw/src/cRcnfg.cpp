@@ -25,6 +25,8 @@
  */
 
 #include "cRcnfg.hpp"
+#include "cThread.hpp"
+#include "cTrace.hpp"
 
 namespace coyote {
 std::atomic<uint32_t> cRcnfg::crid_gen; 
@@ -158,6 +160,8 @@ void cRcnfg::reconfigureBase(bitstream_t bitstream, uint32_t vfid) {
 		<< std::dec << ", length " << std::get<1>(bitstream) << " and vFPGA ID " << vfid
 	);
 
+	TRACE_SCOPE(cTraceEvent::RECONFIG, -1, static_cast<uint64_t>(static_cast<int32_t>(vfid)), std::get<1>(bitstream));
+
 	// Arguments to be passed to the driver's IOCTL call
 	uint64_t tmp[MAX_USER_ARGS];
 	tmp[0] = reinterpret_cast<uint64_t>(std::get<0>(bitstream));
@@ -193,6 +197,9 @@ void cRcnfg::reconfigureShell(std::string bitstream_path) {
 	bitstream_t bitstream = readBitstream(bitstream_file);
 	bitstream_file.close();
 	reconfigureBase(bitstream);
+
+	// The cached shell configuration and register mappings of this process are stale after a shell reconfiguration
+	cThread::releaseShellCache();
 }
 
 void cRcnfg::reconfigureApp(std::string bitstream_path, int vfid) {
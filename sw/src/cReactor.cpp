@@ -0,0 +1,215 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cReactor.hpp"
+#include "cThread.hpp"
+#include "cTrace.hpp"
+
+namespace coyote {
+
+cReactor& cReactor::getInstance() {
+    static cReactor reactor;
+    return reactor;
+}
+
+/// Fails the futures of operations removed before they completed
+static void failRemoved(std::vector<cPromise> &removed) {
+    for (auto &promise : removed) {
+        promise.setException(std::make_exception_ptr(
+            std::runtime_error("ERROR: cReactor - cThread destroyed before the operation completed")
+        ));
+    }
+    removed.clear();
+}
+
+cReactor::~cReactor() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    cv.notify_all();
+    removals_cv.notify_all();
+
+    if (reactor_thread.joinable()) {
+        reactor_thread.join();
+    }
+}
+
+cFuture cReactor::watch(const cThread *thread, cmplToken token) {
+    int32_t cls = cCmplQueue::getTokenClass(token);
+    cPromise promise(token);
+
+    // Nothing to track, the operation has already completed
+    if (cls < 0) {
+        promise.setReady();
+        return promise.getFuture();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!reactor_thread.joinable()) {
+            DBG1("cReactor: Starting the reactor thread");
+            reactor_thread = std::thread(&cReactor::run, this);
+        }
+        inbox.push_back({ .thread = thread, .oper = cCmplQueue::getClassOper(cls), .token = token, .promise = promise });
+        n_watches.fetch_add(1, std::memory_order_relaxed);
+        pending.store(true, std::memory_order_release);
+    }
+    cv.notify_one();
+
+    return promise.getFuture();
+}
+
+size_t cReactor::removeWatches(std::vector<cWatch> &list, const cThread *thread, std::vector<cPromise> &removed) {
+    auto it = std::stable_partition(list.begin(), list.end(), [&](const cWatch &w) { return w.thread != thread; });
+    size_t n_removed = std::distance(it, list.end());
+    for (auto w = it; w != list.end(); w++) {
+        removed.push_back(w->promise);
+    }
+    list.erase(it, list.end());
+    return n_removed;
+}
+
+void cReactor::removeThread(const cThread *thread) {
+    std::vector<cPromise> removed;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        n_watches.fetch_sub(removeWatches(inbox, thread, removed), std::memory_order_relaxed);
+
+        if (reactor_thread.joinable() && std::this_thread::get_id() == reactor_thread.get_id()) {
+            // Called from a continuation on the reactor thread, which isn't in a sweep, so its list can be modified directly
+            n_watches.fetch_sub(removeWatches(watches, thread, removed), std::memory_order_relaxed);
+        } else if (reactor_thread.joinable()) {
+            // Otherwise, the reactor thread removes the operations between two sweeps, after which it no longer accesses the cThread
+            uint64_t ticket = ++n_removals_requested;
+            removals.push_back(thread);
+            pending.store(true, std::memory_order_release);
+            cv.notify_one();
+            removals_cv.wait(lock, [&] { return stop || n_removals_done >= ticket; });
+        }
+    }
+
+    failRemoved(removed);
+}
+
+size_t cReactor::getNumWatches() {
+    return n_watches.load(std::memory_order_relaxed);
+}
+
+void cReactor::run() {
+    std::vector<cPromise> completed;
+    std::vector<cPromise> removed;
+    std::vector<const cThread*> curr_removals;
+    uint32_t backoff = 1;
+
+    while (true) {
+        // Take over new operations and removals; the lock is only held for the hand-over, never during a sweep
+        if (watches.empty() || pending.load(std::memory_order_acquire)) {
+            uint64_t n_requested;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&] { return stop || !watches.empty() || !inbox.empty() || !removals.empty(); });
+                if (stop) {
+                    return;
+                }
+
+                if (watches.empty()) {
+                    watches.swap(inbox);
+                } else {
+                    std::move(inbox.begin(), inbox.end(), std::back_inserter(watches));
+                    inbox.clear();
+                }
+                curr_removals.swap(removals);
+                n_requested = n_removals_requested;
+                pending.store(false, std::memory_order_relaxed);
+            }
+
+            if (!curr_removals.empty()) {
+                for (const cThread *thread : curr_removals) {
+                    n_watches.fetch_sub(removeWatches(watches, thread, removed), std::memory_order_relaxed);
+                }
+                curr_removals.clear();
+                failRemoved(removed);
+
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    n_removals_done = n_requested;
+                }
+                removals_cv.notify_all();
+            }
+        }
+
+        // Single sweep over all the registered operations; consecutive operations of the same
+        // cThread and class share the counter read and the remaining operations are compacted in-place
+        const cThread *last_thread = nullptr;
+        CoyoteOper last_oper = CoyoteOper::NOOP;
+        uint32_t cnt = 0;
+
+        size_t n_remaining = 0;
+        for (size_t i = 0; i < watches.size(); i++) {
+            cWatch &w = watches[i];
+            if (w.thread != last_thread || w.oper != last_oper) {
+                cnt = w.thread->checkCompleted(w.oper);
+                last_thread = w.thread;
+                last_oper = w.oper;
+            }
+
+            if (cCmplQueue::isCompleted(w.token, cnt)) {
+                TRACE_INSTANT(cTraceEvent::COMPLETION, w.thread->getCtid(), static_cast<uint64_t>(w.oper), w.token);
+                completed.push_back(std::move(w.promise));
+            } else {
+                if (n_remaining != i) {
+                    watches[n_remaining] = std::move(w);
+                }
+                n_remaining++;
+            }
+        }
+        watches.erase(watches.begin() + n_remaining, watches.end());
+        n_watches.fetch_sub(completed.size(), std::memory_order_relaxed);
+
+        // Complete the futures; continuations may issue new asynchronous operations, which go through the inbox
+        for (auto &promise : completed) {
+            promise.setReady();
+        }
+
+        // If nothing completed, back off (up to a bound), to reduce the pressure of the counter reads on the memory system
+        if (completed.empty()) {
+            for (uint32_t i = 0; i < backoff; i++) {
+                cpuRelax();
+            }
+            backoff = std::min(2 * backoff, REACTOR_MAX_BACKOFF);
+        } else {
+            backoff = 1;
+        }
+        completed.clear();
+    }
+}
+
+}
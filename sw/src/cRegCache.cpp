@@ -0,0 +1,233 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdexcept>
+
+#include "cRegCache.hpp"
+
+namespace coyote {
+
+cRegCache::cRegCache(std::function<void(void*, uint32_t)> map_fn, std::function<void(void*)> unmap_fn) : 
+    map_fn(std::move(map_fn)), unmap_fn(std::move(unmap_fn)) {}
+
+std::map<uint64_t, cRegCache::cRegEntry>::iterator cRegCache::findFirst(uint64_t addr) {
+    auto it = entries.upper_bound(addr);
+    if (it != entries.begin() && std::prev(it)->second.end > addr) {
+        return std::prev(it);
+    }
+    return it;
+}
+
+void cRegCache::touch(std::map<uint64_t, cRegEntry>::iterator it) {
+    lru_list.splice(lru_list.begin(), lru_list, it->second.lru);
+}
+
+std::map<uint64_t, cRegCache::cRegEntry>::iterator cRegCache::evict(std::map<uint64_t, cRegEntry>::iterator it) {
+    DBG3("cRegCache: Unregistering range " << std::hex << it->first << " - " << it->second.end << std::dec);
+
+    for (auto &map : it->second.maps) {
+        unmap_fn(reinterpret_cast<void*>(map.first));
+    }
+    stats.pinned_bytes -= it->second.end - it->first;
+    lru_list.erase(it->second.lru);
+    return entries.erase(it);
+}
+
+void cRegCache::merge(uint64_t start, uint64_t end) {
+    // Start from the entry containing the page before the range, which may be adjacent to the first new entry
+    auto it = findFirst(start == 0 ? 0 : start - 1);
+    while (it != entries.end() && it->first <= end) {
+        auto next = std::next(it);
+        if (
+            next != entries.end() && next->first <= end && 
+            !it->second.user && !next->second.user && it->second.end == next->first
+        ) {
+            it->second.maps.insert(it->second.maps.end(), next->second.maps.begin(), next->second.maps.end());
+            it->second.end = next->second.end;
+            lru_list.erase(next->second.lru);
+            entries.erase(next);
+            touch(it);
+        } else {
+            it = next;
+        }
+    }
+}
+
+void cRegCache::shrink(uint64_t start, uint64_t end) {
+    while (stats.pinned_bytes > budget && !lru_list.empty()) {
+        auto it = entries.find(lru_list.back());
+
+        // All the entries of the current range were just used, so the remaining entries can't be evicted either
+        if (it->first < end && it->second.end > start) {
+            break;
+        }
+
+        evict(it);
+        stats.n_evictions++;
+    }
+}
+
+void cRegCache::setEnabled(bool enable, uint64_t budget) {
+    std::lock_guard<std::mutex> lock(mtx);
+    this->budget = budget;
+    enabled.store(enable);
+
+    if (enable) {
+        shrink(0, 0);
+    } else {
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->second.user ? std::next(it) : evict(it);
+        }
+    }
+}
+
+void cRegCache::acquire(const void *addr, uint64_t len) {
+    if (!enabled.load() || len == 0) {
+        return;
+    }
+
+    uint64_t start = reinterpret_cast<uint64_t>(addr) & ~(PAGE_SIZE - 1);
+    uint64_t end = (reinterpret_cast<uint64_t>(addr) + len + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Walk the entries overlapping the range and collect the gaps between them
+    std::vector<std::pair<uint64_t, uint64_t>> gaps;
+    uint64_t curr = start;
+    for (auto it = findFirst(start); curr < end; it++) {
+        if (it == entries.end() || it->first >= end) {
+            gaps.emplace_back(curr, end);
+            break;
+        }
+
+        if (it->first > curr) {
+            gaps.emplace_back(curr, it->first);
+        }
+
+        if (!it->second.user) {
+            touch(it);
+        }
+        curr = it->second.end;
+    }
+
+    if (gaps.empty()) {
+        stats.n_hits++;
+        return;
+    }
+    stats.n_misses++;
+
+    // Register only the gaps, so that no page is pinned twice
+    for (auto &gap : gaps) {
+        for (uint64_t offs = gap.first; offs < gap.second; offs += REG_CACHE_MAX_MAP) {
+            uint32_t map_len = static_cast<uint32_t>(std::min(gap.second - offs, static_cast<uint64_t>(REG_CACHE_MAX_MAP)));
+            DBG3("cRegCache: Registering range " << std::hex << offs << " - " << offs + map_len << std::dec);
+            map_fn(reinterpret_cast<void*>(offs), map_len);
+            stats.n_maps++;
+
+            cRegEntry entry;
+            entry.end = offs + map_len;
+            entry.maps.emplace_back(offs, map_len);
+            lru_list.push_front(offs);
+            entry.lru = lru_list.begin();
+            entries.emplace(offs, std::move(entry));
+            stats.pinned_bytes += map_len;
+        }
+    }
+
+    merge(start, end);
+    shrink(start, end);
+}
+
+void cRegCache::acquire(const localSg *sgs, size_t n_sgs) {
+    if (!enabled.load()) {
+        return;
+    }
+
+    // Card memory isn't registered through userMap
+    for (size_t i = 0; i < n_sgs; i++) {
+        if (sgs[i].stream == STRM_HOST) {
+            acquire(sgs[i].addr, sgs[i].len);
+        }
+    }
+}
+
+void cRegCache::insertUser(void *vaddr, uint32_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    uint64_t start = reinterpret_cast<uint64_t>(vaddr) & ~(PAGE_SIZE - 1);
+    uint64_t end = (reinterpret_cast<uint64_t>(vaddr) + len + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Ranges registered twice by the user are only tracked once
+    auto it = findFirst(start);
+    if (it != entries.end() && it->first < end) {
+        DBG3("cRegCache: Range " << vaddr << " overlaps another registration; not tracked");
+        return;
+    }
+
+    cRegEntry entry;
+    entry.end = end;
+    entry.user = true;
+    entry.maps.emplace_back(reinterpret_cast<uint64_t>(vaddr), len);
+    entries.emplace(start, std::move(entry));
+}
+
+void cRegCache::removeUser(void *vaddr) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = entries.find(reinterpret_cast<uint64_t>(vaddr) & ~(PAGE_SIZE - 1));
+    if (it != entries.end() && it->second.user && it->second.maps[0].first == reinterpret_cast<uint64_t>(vaddr)) {
+        entries.erase(it);
+    }
+}
+
+void cRegCache::invalidate(const void *addr, uint64_t len) {
+    uint64_t start = reinterpret_cast<uint64_t>(addr) & ~(PAGE_SIZE - 1);
+    uint64_t end = (reinterpret_cast<uint64_t>(addr) + len + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = findFirst(start); it != entries.end() && it->first < end;) {
+        it = it->second.user ? std::next(it) : evict(it);
+    }
+}
+
+void cRegCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = entries.begin(); it != entries.end();) {
+        it = it->second.user ? entries.erase(it) : evict(it);
+    }
+}
+
+cRegCacheStats cRegCache::getStats() {
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.n_entries = entries.size();
+    return stats;
+}
+
+}
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sstream>
+
+#include "cStats.hpp"
+
+namespace coyote {
+
+void cThreadCounters::snapshot(cThreadStats &stats) const {
+    for (uint32_t i = 0; i < N_COYOTE_OPERS; i++) {
+        stats.n_ops[i] = n_ops[i].load(std::memory_order_relaxed);
+        stats.n_cmds[i] = n_cmds[i].load(std::memory_order_relaxed);
+        stats.n_bytes[i] = n_bytes[i].load(std::memory_order_relaxed);
+    }
+
+    stats.n_csr_writes = n_csr_writes.load(std::memory_order_relaxed);
+    stats.n_csr_reads = n_csr_reads.load(std::memory_order_relaxed);
+    stats.n_map_ioctls = n_map_ioctls.load(std::memory_order_relaxed);
+    stats.n_unmap_ioctls = n_unmap_ioctls.load(std::memory_order_relaxed);
+    stats.n_irqs = n_irqs.load(std::memory_order_relaxed);
+
+    stats.stall = getStallStats();
+    stats.wait = getWaitStats();
+}
+
+cmdStallStats cThreadCounters::getStallStats() const {
+    cmdStallStats stats;
+    stats.n_stalls = n_stalls.load(std::memory_order_relaxed);
+    stats.n_polls = n_polls.load(std::memory_order_relaxed);
+    stats.stall_ns = stall_ns.load(std::memory_order_relaxed);
+    stats.max_stall_ns = max_stall_ns.load(std::memory_order_relaxed);
+    return stats;
+}
+
+cmplWaitStats cThreadCounters::getWaitStats() const {
+    cmplWaitStats stats;
+    stats.n_waits = n_waits.load(std::memory_order_relaxed);
+    stats.n_sleeps = n_sleeps.load(std::memory_order_relaxed);
+    stats.n_irq_wakeups = n_irq_wakeups.load(std::memory_order_relaxed);
+    stats.n_timeouts = n_timeouts.load(std::memory_order_relaxed);
+    stats.sleep_ns = sleep_ns.load(std::memory_order_relaxed);
+    stats.final_sleep_ns = final_sleep_ns.load(std::memory_order_relaxed);
+    stats.max_final_sleep_ns = max_final_sleep_ns.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* getOperName(CoyoteOper oper) {
+    switch (oper) {
+        case CoyoteOper::NOOP: return "NOOP";
+        case CoyoteOper::LOCAL_READ: return "LOCAL_READ";
+        case CoyoteOper::LOCAL_WRITE: return "LOCAL_WRITE";
+        case CoyoteOper::LOCAL_TRANSFER: return "LOCAL_TRANSFER";
+        case CoyoteOper::LOCAL_OFFLOAD: return "LOCAL_OFFLOAD";
+        case CoyoteOper::LOCAL_SYNC: return "LOCAL_SYNC";
+        case CoyoteOper::REMOTE_RDMA_READ: return "REMOTE_RDMA_READ";
+        case CoyoteOper::REMOTE_RDMA_WRITE: return "REMOTE_RDMA_WRITE";
+        case CoyoteOper::REMOTE_RDMA_SEND: return "REMOTE_RDMA_SEND";
+        case CoyoteOper::REMOTE_TCP_SEND: return "REMOTE_TCP_SEND";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string toJson(const cThreadStats &stats) {
+    std::ostringstream out;
+    out << "{\"vfid\":" << stats.vfid << ",\"ctid\":" << stats.ctid;
+
+    out << ",\"opers\":{";
+    bool first = true;
+    for (uint32_t i = 0; i < N_COYOTE_OPERS; i++) {
+        if (!stats.n_ops[i] && !stats.n_cmds[i]) {
+            continue;
+        }
+        out << (first ? "" : ",") << "\"" << getOperName(static_cast<CoyoteOper>(i)) << "\":{";
+        out << "\"ops\":" << stats.n_ops[i] << ",\"cmds\":" << stats.n_cmds[i] << ",\"bytes\":" << stats.n_bytes[i] << "}";
+        first = false;
+    }
+    out << "}";
+
+    out << ",\"csr\":{\"writes\":" << stats.n_csr_writes << ",\"reads\":" << stats.n_csr_reads << "}";
+    out << ",\"ioctl\":{\"map\":" << stats.n_map_ioctls << ",\"unmap\":" << stats.n_unmap_ioctls << "}";
+    out << ",\"irqs\":" << stats.n_irqs;
+
+    out << ",\"stall\":{\"stalls\":" << stats.stall.n_stalls << ",\"polls\":" << stats.stall.n_polls;
+    out << ",\"stall_ns\":" << stats.stall.stall_ns << ",\"max_stall_ns\":" << stats.stall.max_stall_ns << "}";
+
+    out << ",\"wait\":{\"waits\":" << stats.wait.n_waits << ",\"sleeps\":" << stats.wait.n_sleeps;
+    out << ",\"irq_wakeups\":" << stats.wait.n_irq_wakeups << ",\"timeouts\":" << stats.wait.n_timeouts;
+    out << ",\"sleep_ns\":" << stats.wait.sleep_ns << ",\"final_sleep_ns\":" << stats.wait.final_sleep_ns;
+    out << ",\"max_final_sleep_ns\":" << stats.wait.max_final_sleep_ns << "}";
+
+    out << ",\"reg_cache\":{\"hits\":" << stats.reg_cache.n_hits << ",\"misses\":" << stats.reg_cache.n_misses;
+    out << ",\"maps\":" << stats.reg_cache.n_maps << ",\"evictions\":" << stats.reg_cache.n_evictions;
+    out << ",\"pinned_bytes\":" << stats.reg_cache.pinned_bytes << ",\"entries\":" << stats.reg_cache.n_entries << "}";
+
+    out << "}";
+    return out.str();
+}
+
+std::string toPrometheus(const cThreadStats &stats, bool help) {
+    std::ostringstream out;
+    std::string labels = "vfid=\"" + std::to_string(stats.vfid) + "\",ctid=\"" + std::to_string(stats.ctid) + "\"";
+
+    auto header = [&](const char *name, const char *type, const char *desc) {
+        if (help) {
+            out << "# HELP coyote_" << name << " " << desc << "\n";
+            out << "# TYPE coyote_" << name << " " << type << "\n";
+        }
+    };
+
+    auto metric = [&](const char *name, const char *type, const char *desc, uint64_t val) {
+        header(name, type, desc);
+        out << "coyote_" << name << "{" << labels << "} " << val << "\n";
+    };
+
+    auto oper_metric = [&](const char *name, const char *desc, const uint64_t *vals) {
+        header(name, "counter", desc);
+        for (uint32_t i = 0; i < N_COYOTE_OPERS; i++) {
+            if (vals[i]) {
+                out << "coyote_" << name << "{" << labels << ",oper=\"" << getOperName(static_cast<CoyoteOper>(i)) << "\"} " << vals[i] << "\n";
+            }
+        }
+    };
+
+    oper_metric("ops_total", "Invoked operations", stats.n_ops);
+    oper_metric("cmds_total", "DMA commands posted to the vFPGA", stats.n_cmds);
+    oper_metric("bytes_total", "Bytes moved", stats.n_bytes);
+
+    metric("csr_writes_total", "counter", "Control register writes", stats.n_csr_writes);
+    metric("csr_reads_total", "counter", "Control register reads", stats.n_csr_reads);
+    metric("map_ioctls_total", "counter", "Page-mapping ioctls", stats.n_map_ioctls);
+    metric("unmap_ioctls_total", "counter", "Page-unmapping ioctls", stats.n_unmap_ioctls);
+    metric("irqs_total", "counter", "User interrupts handled", stats.n_irqs);
+
+    metric("cmd_stalls_total", "counter", "Command submissions stalled on a full command FIFO", stats.stall.n_stalls);
+    metric("cmd_polls_total", "counter", "Reads of the outstanding commands from the vFPGA", stats.stall.n_polls);
+    metric("cmd_stall_ns_total", "counter", "Time spent waiting on the command FIFO, in nanoseconds", stats.stall.stall_ns);
+    metric("cmd_stall_max_ns", "gauge", "Longest single wait on the command FIFO, in nanoseconds", stats.stall.max_stall_ns);
+
+    metric("waits_total", "counter", "Blocking waits for completions", stats.wait.n_waits);
+    metric("wait_sleeps_total", "counter", "Blocking waits that fell back to sleeping", stats.wait.n_sleeps);
+    metric("wait_irq_wakeups_total", "counter", "Sleeping waits woken up by a user interrupt", stats.wait.n_irq_wakeups);
+    metric("wait_timeouts_total", "counter", "Blocking waits that timed out", stats.wait.n_timeouts);
+    metric("wait_sleep_ns_total", "counter", "Time spent sleeping in blocking waits, in nanoseconds", stats.wait.sleep_ns);
+    metric("wait_final_sleep_ns_total", "counter", "Duration of the final sleep of sleeping waits, in nanoseconds", stats.wait.final_sleep_ns);
+    metric("wait_final_sleep_max_ns", "gauge", "Longest final sleep of a sleeping wait, in nanoseconds", stats.wait.max_final_sleep_ns);
+
+    metric("reg_cache_hits_total", "counter", "Registration cache hits", stats.reg_cache.n_hits);
+    metric("reg_cache_misses_total", "counter", "Registration cache misses", stats.reg_cache.n_misses);
+    metric("reg_cache_maps_total", "counter", "Registrations issued by the registration cache", stats.reg_cache.n_maps);
+    metric("reg_cache_evictions_total", "counter", "Registration cache evictions", stats.reg_cache.n_evictions);
+    metric("reg_cache_pinned_bytes", "gauge", "Memory pinned by the registration cache, in bytes", stats.reg_cache.pinned_bytes);
+    metric("reg_cache_entries", "gauge", "Entries in the registration cache", stats.reg_cache.n_entries);
+
+    return out.str();
+}
+
+}
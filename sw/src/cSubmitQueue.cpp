@@ -0,0 +1,91 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cSubmitQueue.hpp"
+
+namespace coyote {
+
+cSubmitQueue::cSubmitQueue() : slots(new cSubmitSlot[SUBMIT_QUEUE_DEPTH]) {}
+
+void cSubmitQueue::lock() {
+    while (res_lock.test_and_set(std::memory_order_acquire)) {
+        cpuRelax();
+    }
+}
+
+void cSubmitQueue::unlock() {
+    res_lock.clear(std::memory_order_release);
+}
+
+uint64_t cSubmitQueue::reserve() {
+    // If the ring is full, help draining it; the lock is released meanwhile, since the producers of the 
+    // reserved, but not yet published, slots may need it to make progress
+    while (head - tail.load(std::memory_order_acquire) >= SUBMIT_QUEUE_DEPTH) {
+        unlock();
+        if (!flush()) {
+            cpuRelax();
+        }
+        lock();
+    }
+    return head++;
+}
+
+void cSubmitQueue::publish(uint64_t pos, cSubmitReq *req) {
+    cSubmitSlot &slot = slots[pos % SUBMIT_QUEUE_DEPTH];
+    slot.req = req;
+    slot.seq.store(pos + 1, std::memory_order_release);
+}
+
+bool cSubmitQueue::flush() {
+    if (flushing.test_and_set(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // Post requests in order, until reaching one that hasn't been published yet; its producer will flush it
+    while (true) {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        cSubmitSlot &slot = slots[pos % SUBMIT_QUEUE_DEPTH];
+        if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+
+        // The request is owned by its producer, so the slot can be released before the request is posted
+        cSubmitReq *req = slot.req;
+        tail.store(pos + 1, std::memory_order_release);
+
+        try {
+            req->run(req);
+        } catch (...) {
+            req->exc = std::current_exception();
+        }
+        req->done.store(true, std::memory_order_release);
+    }
+
+    flushing.clear(std::memory_order_release);
+    return true;
+}
+
+}
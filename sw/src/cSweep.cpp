@@ -0,0 +1,287 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "cSweep.hpp"
+
+namespace coyote {
+
+/// Columns of the CSV output, in order
+static const std::vector<std::string> CSV_COLUMNS = {
+    "size", "oper", "threads", "queue_depth", "samples", "avg_ns", "std_dev_ns", "min_ns", "p50_ns", "p99_ns", "max_ns",
+    "ops_per_sec", "ops_per_sec_lo", "ops_per_sec_hi", "bytes_per_sec", "bytes_per_sec_lo", "bytes_per_sec_hi"
+};
+
+/// Utility function, returns true if a name can be written to the CSV and JSON output as is, without quoting or escaping
+static bool isPlainName(const std::string &name) {
+    for (char c : name) {
+        if (c == ',' || c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Utility function, writing a number as JSON; JSON has no representation of NaN and infinity, so these are written as null
+static void writeJsonNumber(std::ostream &out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+std::vector<cSweepPoint> cSweepGrid::getPoints() const {
+    std::vector<cSweepPoint> points;
+    for (uint64_t size : sizes) {
+        for (const std::string &oper : opers) {
+            for (unsigned int n_threads : threads) {
+                for (unsigned int queue_depth : queue_depths) {
+                    points.push_back({ size, oper, n_threads, queue_depth });
+                }
+            }
+        }
+    }
+    return points;
+}
+
+std::vector<uint64_t> cSweepGrid::powersOfTwo(uint64_t min_size, uint64_t max_size) {
+    std::vector<uint64_t> sizes;
+    for (uint64_t size = min_size; size > 0 && size <= max_size; size *= 2) {
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+cSweep::cSweep(const std::string &name, const cSweepGrid &grid): name(name), grid(grid) {
+    if (!isPlainName(name)) {
+        throw std::runtime_error("ERROR: cSweep() - the sweep name must not contain commas, quotes, backslashes or control characters: " + name);
+    }
+
+    for (const std::string &oper : grid.opers) {
+        if (!isPlainName(oper)) {
+            throw std::runtime_error("ERROR: cSweep() - operation names must not contain commas, quotes, backslashes or control characters: " + oper);
+        }
+    }
+}
+
+std::vector<cSweepPoint> cSweep::getPoints() const { return grid.getPoints(); }
+
+const std::vector<cSweepResult>& cSweep::getResults() const { return results; }
+
+void cSweep::add(const cSweepPoint &point, const cBench &bench) {
+    results.push_back({
+        point, bench.getHistogram().getCount(), 
+        bench.getAvg(), bench.getStdDev(), bench.getMin(), bench.getP50(), bench.getP99(), bench.getMax(),
+        bench.getOpsPerSec(), bench.getBytesPerSec()
+    });
+}
+
+void cSweep::add(const cSweepPoint &point, const cHistogram &times, uint64_t n_bytes, uint64_t n_ops) {
+    results.push_back({
+        point, times.getCount(), 
+        times.getMean(), times.getStdDev(), times.getMin(), times.getPercentile(50), times.getPercentile(99), times.getMax(),
+        cBench::getRate(times, (double) n_ops), cBench::getRate(times, (double) n_bytes)
+    });
+}
+
+void cSweep::writeCsv(std::ostream &os) const {
+    // Formatted separately, so that the precision of the given stream isn't changed
+    std::ostringstream out;
+    for (size_t i = 0; i < CSV_COLUMNS.size(); i++) {
+        out << (i ? "," : "") << CSV_COLUMNS[i];
+    }
+    out << std::endl;
+
+    out << std::setprecision(12);
+    for (const cSweepResult &r : results) {
+        out << r.point.size << "," << r.point.oper << "," << r.point.n_threads << "," << r.point.queue_depth << "," << r.n_samples << ",";
+        out << r.avg_time << "," << r.std_dev << "," << r.min_time << "," << r.p50_time << "," << r.p99_time << "," << r.max_time << ",";
+        out << r.ops_per_sec.avg << "," << r.ops_per_sec.lo << "," << r.ops_per_sec.hi << ",";
+        out << r.bytes_per_sec.avg << "," << r.bytes_per_sec.lo << "," << r.bytes_per_sec.hi << std::endl;
+    }
+    os << out.str();
+}
+
+void cSweep::writeJson(std::ostream &os) const {
+    std::ostringstream out;
+    out << std::setprecision(12);
+    out << "{\"name\":\"" << name << "\",\"results\":[";
+    for (size_t i = 0; i < results.size(); i++) {
+        const cSweepResult &r = results[i];
+        out << (i ? "," : "") << "{\"size\":" << r.point.size << ",\"oper\":\"" << r.point.oper << "\"";
+        out << ",\"threads\":" << r.point.n_threads << ",\"queue_depth\":" << r.point.queue_depth << ",\"samples\":" << r.n_samples;
+
+        std::pair<const char*, double> times[] = {
+            { "avg_ns", r.avg_time }, { "std_dev_ns", r.std_dev }, { "min_ns", r.min_time }, 
+            { "p50_ns", r.p50_time }, { "p99_ns", r.p99_time }, { "max_ns", r.max_time }
+        };
+        for (auto &t : times) {
+            out << ",\"" << t.first << "\":";
+            writeJsonNumber(out, t.second);
+        }
+
+        std::pair<const char*, const cBenchInterval*> rates[] = { { "ops_per_sec", &r.ops_per_sec }, { "bytes_per_sec", &r.bytes_per_sec } };
+        for (auto &rate : rates) {
+            out << ",\"" << rate.first << "\":{\"avg\":";
+            writeJsonNumber(out, rate.second->avg);
+            out << ",\"lo\":";
+            writeJsonNumber(out, rate.second->lo);
+            out << ",\"hi\":";
+            writeJsonNumber(out, rate.second->hi);
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "]}" << std::endl;
+    os << out.str();
+}
+
+void cSweep::write(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("ERROR: cSweep::write() - could not open " + path);
+    }
+
+    std::string ext = ".json";
+    if (path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+        writeJson(out);
+    } else {
+        writeCsv(out);
+    }
+}
+
+std::vector<cSweepResult> cSweep::readCsv(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("ERROR: cSweep::readCsv() - could not open " + path);
+    }
+
+    auto split = [](const std::string &line) {
+        std::vector<std::string> fields;
+        std::istringstream fields_in(line);
+        std::string field;
+        while (std::getline(fields_in, field, ',')) {
+            fields.push_back(field);
+        }
+        return fields;
+    };
+
+    // The columns are looked up by their name, so that files with additional or reordered columns can be read as well
+    std::string line;
+    std::getline(in, line);
+    std::vector<std::string> header = split(line);
+    std::unordered_map<std::string, size_t> columns;
+    for (size_t i = 0; i < header.size(); i++) {
+        columns[header[i]] = i;
+    }
+    for (const char *required : { "size", "oper", "threads", "queue_depth", "samples", "avg_ns", "std_dev_ns" }) {
+        if (!columns.count(required)) {
+            throw std::runtime_error("ERROR: cSweep::readCsv() - missing column " + std::string(required) + " in " + path);
+        }
+    }
+
+    std::vector<cSweepResult> baseline;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::vector<std::string> fields = split(line);
+        if (fields.size() != header.size()) {
+            throw std::runtime_error("ERROR: cSweep::readCsv() - malformed line in " + path + ": " + line);
+        }
+        auto get = [&](const char *column) {
+            return columns.count(column) ? std::stod(fields[columns[column]]) : std::numeric_limits<double>::quiet_NaN();
+        };
+
+        cSweepResult r;
+        r.point = { std::stoull(fields[columns["size"]]), fields[columns["oper"]], (unsigned int) get("threads"), (unsigned int) get("queue_depth") };
+        r.n_samples = std::stoull(fields[columns["samples"]]);
+        r.avg_time = get("avg_ns");
+        r.std_dev = get("std_dev_ns");
+        r.min_time = get("min_ns");
+        r.p50_time = get("p50_ns");
+        r.p99_time = get("p99_ns");
+        r.max_time = get("max_ns");
+        r.ops_per_sec = { get("ops_per_sec"), get("ops_per_sec_lo"), get("ops_per_sec_hi") };
+        r.bytes_per_sec = { get("bytes_per_sec"), get("bytes_per_sec_lo"), get("bytes_per_sec_hi") };
+        baseline.push_back(r);
+    }
+
+    return baseline;
+}
+
+std::vector<cSweepComparison> cSweep::compare(const std::vector<cSweepResult> &baseline, double alpha, double threshold) const {
+    std::vector<cSweepComparison> comparison;
+    for (const cSweepResult &r : results) {
+        for (const cSweepResult &b : baseline) {
+            if (!(r.point == b.point)) {
+                continue;
+            }
+
+            double p_value = welchTTest(r.avg_time, r.std_dev, r.n_samples, b.avg_time, b.std_dev, b.n_samples);
+            double change = (r.avg_time - b.avg_time) / b.avg_time;
+            
+            // A NaN p-value (e.g., a single sample) is never significant
+            bool significant = p_value < alpha;
+            comparison.push_back({ r.point, b.avg_time, r.avg_time, change, p_value, significant && change > threshold, significant && change < -threshold });
+            break;
+        }
+    }
+    return comparison;
+}
+
+unsigned int cSweep::printComparison(const std::vector<cSweepComparison> &comparison, std::ostream &os) {
+    std::ostringstream out;
+    out << std::setprecision(4);
+    unsigned int n_regressions = 0, n_improvements = 0;
+    for (const cSweepComparison &c : comparison) {
+        if (!c.regression && !c.improvement) {
+            continue;
+        }
+
+        out << (c.regression ? "REGRESSION: " : "IMPROVEMENT: ");
+        out << "size: " << c.point.size << "; oper: " << c.point.oper << "; threads: " << c.point.n_threads;
+        out << "; queue depth: " << c.point.queue_depth << "; time: " << c.baseline_time << " ns -> " << c.time << " ns ";
+        out << "(" << std::showpos << 100.0 * c.change << std::noshowpos << "%, p = " << c.p_value << ")" << std::endl;
+        n_regressions += c.regression;
+        n_improvements += c.improvement;
+    }
+
+    out << "Compared " << comparison.size() << " cells to the baseline: " << n_regressions << " regressions, " << n_improvements << " improvements" << std::endl;
+    os << out.str();
+    return n_regressions;
+}
+
+}
@@ -24,12 +24,21 @@
  * SOFTWARE.
  */
 
+#include <map>
+#include <sstream>
+#include <poll.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
 #include "cThread.hpp"
+#include "cReactor.hpp"
 
 namespace coyote {
 
-/// Event handler function which processes user interrupts in a dedicated thread
-int eventHandler(int fd, int efd, int terminate_efd, void(*uisr)(int), int32_t ctid) {
+/// Event handler function which processes user interrupts in a dedicated thread; every interrupt also wakes up threads blocked in waitCompleted (wait_efd)
+int eventHandler(int fd, int efd, int terminate_efd, int wait_efd, void(*uisr)(int), int32_t ctid, std::atomic<uint64_t> *n_irqs) {
     DBG1("cThread: Called eventHandler"); 
 
     // Create events to listen on
@@ -82,11 +91,15 @@ int eventHandler(int fd, int efd, int terminate_efd, void(*uisr)(int), int32_t c
                 DBG1("cThread: Caught an event which is " << isr_val);
 
 				uisr(isr_val);
+                statAdd(*n_irqs);
+                TRACE_INSTANT(cTraceEvent::IRQ, ctid, isr_val, 0);
 
                 tmp[0] = ctid;
                 if (ioctl(fd, IOCTL_SET_NOTIFICATION_PROCESSED, &tmp)) {
                     throw std::runtime_error("ERROR: IOCTL_SET_NOTIFICATION_PROCESSED failed");
                 }
+
+                eventfd_write(wait_efd, 1);
 			}
 
             // If event is a terminate_efd, terminate the event thread 
@@ -101,59 +114,135 @@ int eventHandler(int fd, int efd, int terminate_efd, void(*uisr)(int), int32_t c
 	return 0;
 }
 
+/// Utility function, parses a CPU list from sysfs (e.g., 0-7,16-23) into the individual CPU IDs
+static std::vector<uint32_t> parseCpuList(const std::string &cpu_list) {
+    std::vector<uint32_t> cpus;
+    std::stringstream stream(cpu_list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty()) {
+            continue;
+        }
+
+        size_t dash = range.find('-');
+        uint32_t first = std::stoul(range.substr(0, dash));
+        uint32_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+        for (uint32_t cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+/// Utility function, pins a thread to the given CPUs
+static void setThreadAffinity(pthread_t thread, const std::vector<uint32_t> &cpus, const std::string &thread_name) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (uint32_t cpu : cpus) {
+        CPU_SET(cpu, &cpu_set);
+    }
+
+    if (pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set)) {
+        throw std::runtime_error("ERROR: cThread::pinToDevice() - could not set the affinity of the " + thread_name);
+    }
+}
+
+/**
+ * @brief Utility function, sets the NUMA memory policy of a freshly allocated buffer, before it's faulted in by userMap
+ *
+ * @param mem Buffer address; must be page-aligned
+ * @param len Buffer length, in bytes
+ * @param node Target NUMA node; negative values leave the placement to the kernel
+ * @param strict If true, the memory is bound to the node (MPOL_BIND) and failures are reported; otherwise, the node is only preferred
+ */
+static void bindNumaNode(void *mem, uint64_t len, int32_t node, bool strict) {
+    if (node < 0) {
+        return;
+    }
+
+    // Already populated pages (e.g., re-used by malloc) are moved to the target node as well
+    constexpr uint32_t BITS_PER_WORD = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(node / BITS_PER_WORD + 1, 0);
+    node_mask[node / BITS_PER_WORD] |= 1UL << (node % BITS_PER_WORD);
+    long ret_val = syscall(
+        SYS_mbind, mem, len, strict ? MPOL_BIND : MPOL_PREFERRED, 
+        node_mask.data(), node_mask.size() * BITS_PER_WORD + 1, MPOL_MF_MOVE
+    );
+
+    if (ret_val) {
+        if (strict) {
+            throw std::runtime_error("ERROR: cThread::getMem() - could not bind memory to NUMA node " + std::to_string(node));
+        }
+        DBG1("cThread: Could not place memory on NUMA node " << node << ", errno " << errno);
+    }
+}
+
 static unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
 
+/// Per-vFPGA state, which is the same for all the cThreads of a process and hence only set up once (see cThread::mmapFpga)
+struct cShellEntry {
+    int32_t fd = { -1 };
+    uint64_t cnfg = { 0 };
+    int32_t numa_node = { -1 };
+    std::vector<uint32_t> local_cpus;
+
+    #ifdef EN_AVX
+    volatile __m256i *cnfg_reg_avx = { 0 };
+    #endif
+    volatile uint64_t *cnfg_reg = { 0 };
+    volatile uint64_t *ctrl_reg = { 0 };
+    volatile uint32_t *wback = { 0 };
+
+    /// Number of cThreads currently using this entry
+    uint32_t n_users = { 0 };
+};
+
+/// Process-wide cache of the per-vFPGA state, keyed by (device, vfid)
+static std::mutex shell_cache_mtx;
+static std::map<std::pair<uint32_t, int32_t>, cShellEntry> shell_cache;
+
+/// Unmaps the regions of a cached entry and closes its device file
+static void releaseShellEntry(cShellEntry &entry) {
+    fpgaCnfg fcnfg;
+    fcnfg.parseCnfg(entry.cnfg);
+
+    #ifdef EN_AVX
+    if (fcnfg.en_avx) {
+        munmap((void*) entry.cnfg_reg_avx, CNFG_AVX_REGION_SIZE);
+    } else {
+    #endif
+        munmap((void*) entry.cnfg_reg, CNFG_REGION_SIZE);
+    #ifdef EN_AVX
+    }
+    #endif
+
+    munmap((void*) entry.ctrl_reg, CTRL_REGION_SIZE);
+
+    if (fcnfg.en_wb) {
+        munmap((void*) entry.wback, WBACK_REGION_SIZE);
+    }
+
+    close(entry.fd);
+}
+
 cThread::cThread(int32_t vfid, pid_t hpid, uint32_t device, void (*uisr)(int)):
-  hpid(hpid), vfid(vfid),
-  vlock(boost::interprocess::open_or_create, ("mutex_dev_" + std::to_string(device) + "_vfpa_" + std::to_string(vfid)).c_str()) {
+  fd(-1), device(device), vfid(vfid), hpid(hpid), uisr(uisr) {
 	DBG1("cThread: opening vFPGA " << vfid << ", hpid " << hpid);
 
-	// Open char device with the name specified in the driver
-	std::string region = "/dev/coyote_fpga_" + std::to_string(device) + "_v" + std::to_string(vfid);
-    this->fd = open(region.c_str(), O_RDWR | O_SYNC); 
-	if (fd == -1) { 
-        throw std::runtime_error("ERROR: cThread instance could not be obtained, vfid: " + std::to_string(vfid)); 
-    }
+    // Open the device, read the shell configuration and map the registers, or reuse them from another cThread on the same vFPGA
+    mmapFpga();
 
     // Obtain new Coyote thread ID (ctid) and register it with the driver
 	uint64_t tmp[MAX_USER_ARGS];
     tmp[0] = hpid;
 	if (ioctl(fd, IOCTL_REGISTER_CTID, &tmp)) { 
+        munmapFpga();
         throw std::runtime_error("ERROR: IOCTL_REGISTER_CTID failed"); 
     }
     this->ctid = tmp[1];  
 	DBG1("cThread: registered ctid " << ctid);
-	
-    // Read shell configuration from the driver
-	if (ioctl(fd, IOCTL_READ_SHELL_CONFIG, &tmp)) { 
-        throw std::runtime_error("ERROR: IOCTL_READ_SHELL_CONFIG failed"); 
-    }
-	fcnfg.parseCnfg(tmp[0]);
-
-    // Register user interrupt service routine (uisr) and start the interrupt processing thread
-    if (uisr) {
-        DBG1("cThread: user interrupt service routine provided, trying to create efd and terminate_efd"); 
-        
-		efd = eventfd(0, 0);
-		if (efd == -1) { 
-            throw std::runtime_error("ERROR: cThread could not create eventfd"); 
-        }
 
-		terminate_efd = eventfd(0, 0);
-		if (terminate_efd == -1) { 
-            throw std::runtime_error("ERROR: cThread could not create eventfd"); 
-        }
-
-        event_thread = std::thread(eventHandler, fd, efd, terminate_efd, uisr, ctid);
-
-        tmp[0] = ctid; 
-		tmp[1] = efd;
-		if (ioctl(fd, IOCTL_REGISTER_EVENTFD, &tmp)) {
-			throw std::runtime_error("ERROR: IOCTL_REGISTER_EVENTFD failed");
-        }
-
-        DBG1("cThread: user interrupt service routine registered, thread running..."); 
-    }
+    // NOTE: The user interrupt thread, if any, is only started once the vFPGA can raise an interrupt (see startEventThread)
 
     // Set the local QP, if RDMA is enabled
     qpair = std::make_unique<ibvQp>();
@@ -183,8 +272,6 @@ cThread::cThread(int32_t vfid, pid_t hpid, uint32_t device, void (*uisr)(int)):
         DBG2("cThread: RDMA is enabled, created the local QP with QPN " << qpair->local.qpn << ", local PSN " << qpair->local.psn << ", and local rkey " << qpair->local.rkey);
     }
 
-	mmapFpga();
-
 	clearCompleted();
 
     DBG1("cThread: constructor finished");
@@ -193,13 +280,13 @@ cThread::cThread(int32_t vfid, pid_t hpid, uint32_t device, void (*uisr)(int)):
 cThread::~cThread() {
 	DBG1("cThread: destructor, ctid: " << ctid << ", vfid: " << vfid << ", hpid: " << hpid);
 
+    // Stop tracking any asynchronous operations of this thread, before unmapping the completion counters
+    cReactor::getInstance().removeThread(this);
+
     // Release the lock, if acquired
-    if (lock_acquired) {
-        vlock.unlock();
-        lock_acquired = false;
-    }
+    unlock();
 
-    // Free user pages and unmap the mapped regions
+    // Free user pages
 	uint64_t tmp[MAX_USER_ARGS];
     tmp[0] = ctid;
 
@@ -207,7 +294,7 @@ cThread::~cThread() {
 		freeMem(it.first);
 	}
 	mapped_pages.clear();
-	munmapFpga();
+	reg_cache.clear();
 
     // Unregister Coyote thread ID
 	ioctl(fd, IOCTL_UNREGISTER_CTID, &tmp);
@@ -226,12 +313,88 @@ cThread::~cThread() {
         ioctl(fd, IOCTL_SET_NOTIFICATION_PROCESSED, &tmp);
 	}
 
+    if (wait_efd != -1) {
+        close(wait_efd);
+    }
+
     // Disable RDMA, if enabled and set-up
     if (fcnfg.en_rdma && is_connected) {
         closeConn();
     }
 
-	close(fd);
+    // Release the mapped regions and the device file; they're kept in the process-wide cache, for the next cThread
+	munmapFpga();
+}
+
+void cThread::reset() {
+    DBG1("cThread: Called reset, ctid: " << ctid);
+
+    // Fail the futures of any outstanding asynchronous operations, since their tokens are invalidated below
+    cReactor::getInstance().removeThread(this);
+
+    unlock();
+
+    // Drop interrupt wakeups meant for the previous user of this cThread
+    if (wait_efd != -1) {
+        eventfd_t val;
+        eventfd_read(wait_efd, &val);
+    }
+
+    post_oper = CoyoteOper::NOOP;
+    clearCompleted();
+}
+
+void cThread::releaseShellCache() {
+    DBG1("cThread: Called releaseShellCache");
+
+    std::lock_guard<std::mutex> guard(shell_cache_mtx);
+    for (auto it = shell_cache.begin(); it != shell_cache.end();) {
+        if (it->second.n_users == 0) {
+            releaseShellEntry(it->second);
+            it = shell_cache.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void cThread::startEventThread() {
+    std::call_once(event_once, [this]() {
+        DBG1("cThread: user interrupt service routine provided, trying to create efd and terminate_efd"); 
+
+        // Event for waking up threads blocked in waitCompleted; non-blocking, so that it can be drained without blocking
+        wait_efd = eventfd(0, EFD_NONBLOCK);
+        if (wait_efd == -1) { 
+            throw std::runtime_error("ERROR: cThread could not create eventfd"); 
+        }
+
+		efd = eventfd(0, 0);
+		if (efd == -1) { 
+            throw std::runtime_error("ERROR: cThread could not create eventfd"); 
+        }
+
+		terminate_efd = eventfd(0, 0);
+		if (terminate_efd == -1) { 
+            throw std::runtime_error("ERROR: cThread could not create eventfd"); 
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(event_mtx);
+            event_thread = std::thread(eventHandler, fd, efd, terminate_efd, wait_efd, uisr, ctid, &counters.n_irqs);
+            if (!event_cpus.empty()) {
+                setThreadAffinity(event_thread.native_handle(), event_cpus, "user interrupt thread");
+            }
+        }
+
+	    uint64_t tmp[MAX_USER_ARGS];
+        tmp[0] = ctid; 
+		tmp[1] = efd;
+		if (ioctl(fd, IOCTL_REGISTER_EVENTFD, &tmp)) {
+			throw std::runtime_error("ERROR: IOCTL_REGISTER_EVENTFD failed");
+        }
+
+        DBG1("cThread: user interrupt service routine registered, thread running..."); 
+    });
 }
 
 void cThread::postCmd(uint64_t offs_3, uint64_t offs_2, uint64_t offs_1, uint64_t offs_0) {
@@ -240,110 +403,327 @@ void cThread::postCmd(uint64_t offs_3, uint64_t offs_2, uint64_t offs_1, uint64_
         std::hex << offs_3 << ", " << offs_2 << ", " << offs_1 << ", " << offs_0 << std::dec
     );
 
-    // Check outstanding commands; to avoid oversaturating the command FIFO
-    while (cmd_cnt > (CMD_FIFO_DEPTH - CMD_FIFO_THR)) {
-        #ifdef EN_AVX
-        cmd_cnt = fcnfg.en_avx ? LOW_32(_mm256_extract_epi32(cnfg_reg_avx[static_cast<uint32_t>(CnfgAvxRegs::CTRL_REG)], 0x0)) :
-                                cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG)];
-        #else
-        cmd_cnt = cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG)];
-        #endif
+    cmdDesc cmd = { .addr_dst = offs_3, .ctrl_dst = offs_2, .addr_src = offs_1, .ctrl_src = offs_0 };
+    postCmds(&cmd, 1);
+}
+
+void cThread::postCmds(const cmdDesc *cmds, uint32_t n_cmds) {
+    DBG1("cThread: Called postCmds with " << n_cmds << " commands");
+    TRACE_BEGIN(trace_begin);
+    if (uisr) {
+        startEventThread();
+    }
 
-        if (cmd_cnt > (CMD_FIFO_DEPTH - CMD_FIFO_THR)) {
-            std::this_thread::sleep_for(std::chrono::nanoseconds(SLEEP_TIME));
+    uint32_t n_posted = 0;
+    while (n_posted < n_cmds) {
+        // Stream as many commands as the FIFO can currently take, without querying the outstanding commands in-between
+        uint32_t n_credits = acquireCmdCredits(n_cmds - n_posted);
+        for (uint32_t i = 0; i < n_credits; i++) {
+            writeCmd(cmds[n_posted + i]);
         }
+        n_posted += n_credits;
     }
 
-    // Send the commands
+    // Bytes moved by the commands; for two-sided commands, the source length
+    uint64_t n_bytes = 0;
+    for (uint32_t i = 0; i < n_cmds; i++) {
+        uint64_t ctrl = cmds[i].ctrl_src ? cmds[i].ctrl_src : cmds[i].ctrl_dst;
+        n_bytes += (ctrl >> CTRL_LEN_OFFS) & CTRL_LEN_MASK;
+    }
+    statAdd(counters.n_cmds[static_cast<uint32_t>(post_oper)], n_cmds);
+    statAdd(counters.n_bytes[static_cast<uint32_t>(post_oper)], n_bytes);
+    TRACE_END(trace_begin, cTraceEvent::POST_CMDS, ctid, n_cmds, n_bytes);
+}
+
+uint32_t cThread::acquireCmdCredits(uint32_t n_cmds) {
+    // At most (CMD_FIFO_DEPTH - CMD_FIFO_THR + 1) commands can be outstanding, to avoid oversaturating the command FIFO
+    constexpr uint32_t max_outstanding = CMD_FIFO_DEPTH - CMD_FIFO_THR + 1;
+
+    // Shadow credits haven't run out; no need to query the hardware
+    if (cmd_credits == 0) {
+        statAdd(counters.n_polls);
+        uint32_t cmd_cnt = readCmdCnt();
+        cmd_credits = cmd_cnt < max_outstanding ? max_outstanding - cmd_cnt : 0;
+
+        // FIFO is full; wait according to the backoff policy until there is space
+        if (cmd_credits == 0) {
+            DBG1("cThread: Command FIFO full, stalling command submission");
+            auto begin_time = std::chrono::steady_clock::now();
+            TRACE_BEGIN(trace_begin);
+            uint32_t n_pauses = 1;
+
+            while (cmd_credits == 0) {
+                switch (backoff) {
+                    case CoyoteBackoff::SPIN: {
+                        cpuRelax();
+                        break;
+                    }
+                    case CoyoteBackoff::SPIN_YIELD: {
+                        if (n_pauses <= BACKOFF_MAX_PAUSES) {
+                            for (uint32_t i = 0; i < n_pauses; i++) {
+                                cpuRelax();
+                            }
+                            n_pauses *= 2;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                        break;
+                    }
+                    case CoyoteBackoff::SLEEP: {
+                        std::this_thread::sleep_for(std::chrono::nanoseconds(SLEEP_TIME));
+                        break;
+                    }
+                }
+
+                statAdd(counters.n_polls);
+                cmd_cnt = readCmdCnt();
+                cmd_credits = cmd_cnt < max_outstanding ? max_outstanding - cmd_cnt : 0;
+            }
+
+            uint64_t stall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin_time).count();
+            statAdd(counters.n_stalls);
+            statAdd(counters.stall_ns, stall_ns);
+            statMax(counters.max_stall_ns, stall_ns);
+            TRACE_END(trace_begin, cTraceEvent::STALL, ctid, 0, 0);
+        }
+    }
+
+    uint32_t n_credits = std::min(n_cmds, cmd_credits);
+    cmd_credits -= n_credits;
+    return n_credits;
+}
+
+uint32_t cThread::readCmdCnt() const {
+    #ifdef EN_AVX
+    return fcnfg.en_avx ? LOW_32(_mm256_extract_epi32(cnfg_reg_avx[static_cast<uint32_t>(CnfgAvxRegs::CTRL_REG)], 0x0)) :
+                          cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG)];
+    #else
+    return cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG)];
+    #endif
+}
+
+void cThread::writeCmd(const cmdDesc &cmd) {
     #ifdef EN_AVX
     if (fcnfg.en_avx) {
-        cnfg_reg_avx[static_cast<uint32_t>(CnfgAvxRegs::CTRL_REG)] = _mm256_set_epi64x(offs_3, offs_2, offs_1, offs_0);
+        cnfg_reg_avx[static_cast<uint32_t>(CnfgAvxRegs::CTRL_REG)] = _mm256_set_epi64x(cmd.addr_dst, cmd.ctrl_dst, cmd.addr_src, cmd.ctrl_src);
     } else {
     #endif
-        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::VADDR_WR_REG)] = offs_3;
-        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG_2)] = offs_2;
-        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::VADDR_RD_REG)] = offs_1;
-        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG)] = offs_0;
+        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::VADDR_WR_REG)] = cmd.addr_dst;
+        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG_2)] = cmd.ctrl_dst;
+        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::VADDR_RD_REG)] = cmd.addr_src;
+        cnfg_reg[static_cast<uint32_t>(CnfgLegRegs::CTRL_REG)] = cmd.ctrl_src;
     #ifdef EN_AVX
     }
     #endif
+}
 
-    // Increment
-    cmd_cnt++;
+uint64_t cThread::localCtrlCmd(const localSg &sg, bool last) const {
+    return 
+        ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
+        ((sg.dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
+        (last ? CTRL_LAST : 0x0) |
+        ((sg.stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
+        (CTRL_START) | 
+        (0x0) | 
+        (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
+}
+
+cmdDesc cThread::rdmaCmd(CoyoteOper oper, const rdmaSg &sg, bool last) const {
+    // Local command and address
+    uint64_t ctrl_cmd_l =
+        (((static_cast<uint64_t>(oper) - REMOTE_OFFS_OPS) & CTRL_OPCODE_MASK) << CTRL_OPCODE_OFFS) |
+        ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
+        ((sg.local_dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
+        (last ? CTRL_LAST : 0x0) |
+        ((sg.local_stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
+        (0x0) | 
+        (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
+    
+    uint64_t addr_cmd_l = static_cast<uint64_t>((uint64_t) qpair->local.vaddr + sg.local_offs);
+
+    // Remote command and address
+    uint64_t ctrl_cmd_r =                    
+        (((static_cast<uint64_t>(oper) - REMOTE_OFFS_OPS) & CTRL_OPCODE_MASK) << CTRL_OPCODE_OFFS) |
+        ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
+        ((sg.remote_dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
+        (last ? CTRL_LAST : 0x0) |
+        ((STRM_RDMA & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
+        (CTRL_START) |
+        (0x0) | 
+        (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
+
+    uint64_t addr_cmd_r = static_cast<uint64_t>((uint64_t) qpair->remote.vaddr + sg.remote_offs); 
+
+    // Order - based on the distinction between Read and Write, determine what is source and what is destination 
+    uint64_t ctrl_cmd_src = isRemoteRead(oper) ? ctrl_cmd_r : ctrl_cmd_l;
+    uint64_t addr_cmd_src = isRemoteRead(oper) ? addr_cmd_r : addr_cmd_l;
+    uint64_t ctrl_cmd_dst = isRemoteRead(oper) ? ctrl_cmd_l : ctrl_cmd_r;
+    uint64_t addr_cmd_dst = isRemoteRead(oper) ? addr_cmd_l : addr_cmd_r;
+
+    return { .addr_dst = addr_cmd_dst, .ctrl_dst = ctrl_cmd_dst, .addr_src = addr_cmd_src, .ctrl_src = ctrl_cmd_src };
+}
+
+uint32_t cThread::getNumChunks(uint64_t len) const {
+    // Zero-length transfers are still posted as a single command
+    return len == 0 ? 1 : static_cast<uint32_t>((len + chunk_size - 1) / chunk_size);
+}
+
+void cThread::postLocalCmds(const localSg *src_sgs, size_t n_src, const localSg *dst_sgs, size_t n_dst, bool last) {
+    // Position in the scatter-gather list of one side: current entry and the offset of the next chunk in it
+    struct sgCursor {
+        const localSg *sgs;
+        size_t n_sgs;
+        size_t idx;
+        uint64_t offs;
+    };
+    sgCursor src = { src_sgs, n_src, 0, 0 };
+    sgCursor dst = { dst_sgs, n_dst, 0, 0 };
+
+    // Writes the next chunk of one side into the command, if there is one left; zero-length entries are posted as one command
+    auto next_chunk = [&](sgCursor &cur, uint64_t &addr_cmd, uint64_t &ctrl_cmd) {
+        if (cur.idx == cur.n_sgs) {
+            return;
+        }
+
+        const localSg &sg = cur.sgs[cur.idx];
+        localSg chunk = sg;
+        chunk.addr = reinterpret_cast<char *>(sg.addr) + cur.offs;
+        chunk.len = std::min(sg.len - cur.offs, static_cast<uint64_t>(chunk_size));
+
+        cur.offs += chunk.len;
+        if (cur.offs >= sg.len) {
+            cur.idx++;
+            cur.offs = 0;
+        }
+
+        addr_cmd = reinterpret_cast<uint64_t>(chunk.addr);
+        ctrl_cmd = localCtrlCmd(chunk, last && cur.idx == cur.n_sgs);
+    };
+
+    // Encode the chunks in groups of at most CMD_FIFO_DEPTH commands, which are streamed back-to-back;
+    // the i-th command carries the i-th chunk of each side, so once one side runs out, the commands become one-sided
+    cmdDesc cmds[CMD_FIFO_DEPTH];
+    while (src.idx < src.n_sgs || dst.idx < dst.n_sgs) {
+        uint32_t n_group = 0;
+        while (n_group < CMD_FIFO_DEPTH && (src.idx < src.n_sgs || dst.idx < dst.n_sgs)) {
+            cmds[n_group] = { 0 };
+            next_chunk(src, cmds[n_group].addr_src, cmds[n_group].ctrl_src);
+            next_chunk(dst, cmds[n_group].addr_dst, cmds[n_group].ctrl_dst);
+            n_group++;
+        }
+        postCmds(cmds, n_group);
+    }
 }
 
 void cThread::mmapFpga() {
     DBG1("cThread: Called mmapFpga");
 
-	// Config 
-    #ifdef EN_AVX
-	if (fcnfg.en_avx) {
-		cnfg_reg_avx = (__m256i*) mmap(NULL, CNFG_AVX_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, MMAP_CNFG_AVX);
-		if (cnfg_reg_avx == MAP_FAILED) {
-		 	throw std::runtime_error("ERROR: cnfg_reg_avx mmap failed");
+    std::lock_guard<std::mutex> guard(shell_cache_mtx);
+    cShellEntry &entry = shell_cache[{device, vfid}];
+    if (entry.fd == -1) {
+        // Open char device with the name specified in the driver
+        std::string region = "/dev/coyote_fpga_" + std::to_string(device) + "_v" + std::to_string(vfid);
+        entry.fd = open(region.c_str(), O_RDWR | O_SYNC); 
+        if (entry.fd == -1) { 
+            shell_cache.erase({device, vfid});
+            throw std::runtime_error("ERROR: cThread instance could not be obtained, vfid: " + std::to_string(vfid)); 
         }
 
-		DBG1("cThread: mapped cnfg_reg_avx at: " << std::hex << reinterpret_cast<uint64_t>(cnfg_reg_avx) << std::dec);
-	} else {
-    #endif
-		cnfg_reg = (uint64_t*) mmap(NULL, CNFG_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, MMAP_CNFG);
-		if (cnfg_reg == MAP_FAILED) {
-			throw std::runtime_error("ERROR: cnfg_reg mmap failed");
+        // Read shell configuration from the driver
+        uint64_t tmp[MAX_USER_ARGS];
+        if (ioctl(entry.fd, IOCTL_READ_SHELL_CONFIG, &tmp)) { 
+            close(entry.fd);
+            shell_cache.erase({device, vfid});
+            throw std::runtime_error("ERROR: IOCTL_READ_SHELL_CONFIG failed"); 
         }
-		
-		DBG1("cThread: mapped cnfg_reg at: " << std::hex << reinterpret_cast<uint64_t>(cnfg_reg) << std::dec);
-    #ifdef EN_AVX
-	}
-    #endif
+        entry.cnfg = tmp[0];
 
-	// Control - map the user CSRs into memory 
-	ctrl_reg = (uint64_t*) mmap(NULL, CTRL_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, MMAP_CTRL);
-	if (ctrl_reg == MAP_FAILED) {
-		throw std::runtime_error("ERROR: ctrl_reg mmap failed");
-    }
-	
-	DBG1("cThread: mapped ctrl_reg at: " << std::hex << reinterpret_cast<uint64_t>(ctrl_reg) << std::dec);
+        fpgaCnfg cnfg;
+        cnfg.parseCnfg(entry.cnfg);
 
-	// Writeback
-	if (fcnfg.en_wb) {
-		wback = (uint32_t*) mmap(NULL, WBACK_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, MMAP_WB);
-		if (wback == MAP_FAILED) {
-			throw std::runtime_error("ERROR: wback mmap failed");
+        // Read the NUMA node and the local CPUs of the device (the parent of the vFPGA in sysfs); these are unknown on single-socket systems
+        std::string sysfs_dev = 
+            "/sys/class/coyote_fpga_" + std::to_string(device) + "/coyote_fpga_" + std::to_string(device) + "_v" + std::to_string(vfid) + "/device/";
+        std::ifstream numa_file(sysfs_dev + "numa_node");
+        if (!(numa_file >> entry.numa_node)) {
+            entry.numa_node = -1;
         }
 
-		DBG1("cThread: mapped writeback regions at: " << std::hex << reinterpret_cast<uint64_t>(wback) << std::dec);
-	}
-}
+        std::ifstream cpus_file(sysfs_dev + "local_cpulist");
+        std::string cpu_list;
+        if (entry.numa_node >= 0 && std::getline(cpus_file, cpu_list)) {
+            entry.local_cpus = parseCpuList(cpu_list);
+        }
+        DBG1("cThread: device NUMA node " << entry.numa_node << ", " << entry.local_cpus.size() << " local CPUs");
 
-void cThread::munmapFpga() {
-	DBG1("cThread: Called munmapFpga");
+        // Config 
+        #ifdef EN_AVX
+        if (cnfg.en_avx) {
+            entry.cnfg_reg_avx = (__m256i*) mmap(NULL, CNFG_AVX_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, entry.fd, MMAP_CNFG_AVX);
+            if (entry.cnfg_reg_avx == MAP_FAILED) {
+                close(entry.fd);
+                shell_cache.erase({device, vfid});
+                throw std::runtime_error("ERROR: cnfg_reg_avx mmap failed");
+            }
 
-	// Config
-    #ifdef EN_AVX
-	if (fcnfg.en_avx) {
-		if (munmap((void*)cnfg_reg_avx, CNFG_AVX_REGION_SIZE) != 0) {
-			throw std::runtime_error("ERROR: cnfg_reg_avx munmap failed");
+            DBG1("cThread: mapped cnfg_reg_avx at: " << std::hex << reinterpret_cast<uint64_t>(entry.cnfg_reg_avx) << std::dec);
+        } else {
+        #endif
+            entry.cnfg_reg = (uint64_t*) mmap(NULL, CNFG_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, entry.fd, MMAP_CNFG);
+            if (entry.cnfg_reg == MAP_FAILED) {
+                close(entry.fd);
+                shell_cache.erase({device, vfid});
+                throw std::runtime_error("ERROR: cnfg_reg mmap failed");
+            }
+            
+            DBG1("cThread: mapped cnfg_reg at: " << std::hex << reinterpret_cast<uint64_t>(entry.cnfg_reg) << std::dec);
+        #ifdef EN_AVX
         }
-	} else {
-    #endif
-		if (munmap((void*)cnfg_reg, CNFG_REGION_SIZE) != 0) {
-			throw std::runtime_error("ERROR: cnfg_reg munmap failed");
+        #endif
+
+        // Control - map the user CSRs into memory 
+        entry.ctrl_reg = (uint64_t*) mmap(NULL, CTRL_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, entry.fd, MMAP_CTRL);
+        if (entry.ctrl_reg == MAP_FAILED) {
+            close(entry.fd);
+            shell_cache.erase({device, vfid});
+            throw std::runtime_error("ERROR: ctrl_reg mmap failed");
         }
+        
+        DBG1("cThread: mapped ctrl_reg at: " << std::hex << reinterpret_cast<uint64_t>(entry.ctrl_reg) << std::dec);
+
+        // Writeback
+        if (cnfg.en_wb) {
+            entry.wback = (uint32_t*) mmap(NULL, WBACK_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, entry.fd, MMAP_WB);
+            if (entry.wback == MAP_FAILED) {
+                close(entry.fd);
+                shell_cache.erase({device, vfid});
+                throw std::runtime_error("ERROR: wback mmap failed");
+            }
+
+            DBG1("cThread: mapped writeback regions at: " << std::hex << reinterpret_cast<uint64_t>(entry.wback) << std::dec);
+        }
+    } else {
+        DBG1("cThread: reusing the cached mappings of vFPGA " << vfid << ", device " << device);
+    }
+
+    entry.n_users++;
+    fd = entry.fd;
+    fcnfg.parseCnfg(entry.cnfg);
+    numa_node = entry.numa_node;
+    local_cpus = entry.local_cpus;
     #ifdef EN_AVX
-	}
+    cnfg_reg_avx = entry.cnfg_reg_avx;
     #endif
+    cnfg_reg = entry.cnfg_reg;
+    ctrl_reg = entry.ctrl_reg;
+    wback = entry.wback;
+}
 
-	// User CSRs
-	if (munmap((void*)ctrl_reg, CTRL_REGION_SIZE) != 0) {
-		throw std::runtime_error("ERROR: ctrl_reg munmap failed");
-    }
+void cThread::munmapFpga() {
+	DBG1("cThread: Called munmapFpga");
 
-	// Writeback
-	if (fcnfg.en_wb) {
-		if (munmap((void*)wback, WBACK_REGION_SIZE) != 0) {
-			throw std::runtime_error("ERROR: wback munmap failed");
-        }
-	}
+    std::lock_guard<std::mutex> guard(shell_cache_mtx);
+    shell_cache[{device, vfid}].n_users--;
 
     #ifdef EN_AVX
 	cnfg_reg_avx = 0;
@@ -354,42 +734,64 @@ void cThread::munmapFpga() {
 }
 
 void cThread::userMap(void *vaddr, uint32_t len) {
+    TRACE_SCOPE(cTraceEvent::USER_MAP, ctid, reinterpret_cast<uint64_t>(vaddr), len);
     DBG1("cThread: Called userMap to map user buffer, vaddr " << vaddr << ", length " << len << " and ctid " << ctid);
 
+    // Release any cached registrations of the same pages first, so that they don't unmap the buffer once evicted
+    reg_cache.invalidate(vaddr, len);
+    mapUserMem(vaddr, len);
+    reg_cache.insertUser(vaddr, len);
+}
+
+void cThread::userUnmap(void *vaddr) {
+    TRACE_SCOPE(cTraceEvent::USER_UNMAP, ctid, reinterpret_cast<uint64_t>(vaddr), 0);
+    DBG1("cThread: Called userUnmap to unmap user buffers");
+
+    reg_cache.removeUser(vaddr);
+    unmapUserMem(vaddr);
+}
+
+void cThread::mapUserMem(void *vaddr, uint32_t len) {
     uint64_t tmp[MAX_USER_ARGS];
 	tmp[0] = reinterpret_cast<uint64_t>(vaddr);
 	tmp[1] = static_cast<uint64_t>(len);
 	tmp[2] = static_cast<uint64_t>(ctid);
 
+	statAdd(counters.n_map_ioctls);
 	if (ioctl(fd, IOCTL_MAP_USER_MEM, &tmp)) {
 		throw std::runtime_error("ERROR: IOCTL_MAP_USER_MEM failed");
     }
 }
 
-void cThread::userUnmap(void *vaddr) {
-    DBG1("cThread: Called userUnmap to unmap user buffers");
-
+void cThread::unmapUserMem(void *vaddr) {
 	uint64_t tmp[MAX_USER_ARGS];
 	tmp[0] = reinterpret_cast<uint64_t>(vaddr);
 	tmp[1] = static_cast<uint64_t>(ctid);
 
+    statAdd(counters.n_unmap_ioctls);
     if (ioctl(fd, IOCTL_UNMAP_USER_MEM, &tmp)) {
         throw std::runtime_error("ERROR: IOCTL_UNMAP_USER_MEM failed");
     }
 }
 
 void* cThread::getMem(CoyoteAlloc&& alloc) {
+    TRACE_SCOPE(cTraceEvent::GET_MEM, ctid, static_cast<uint64_t>(alloc.alloc), alloc.size);
     DBG1("cThread: Called getMem to obtain memory with size " << alloc.size); 
 
 	void *mem = nullptr;
 	void *memNonAligned = nullptr;
 
+    // Place host memory on the device's NUMA node, unless overridden in the allocation
+    int32_t node = alloc.numa_node == NUMA_NODE_DEVICE ? numa_node : alloc.numa_node;
+    bool strict_node = alloc.numa_node >= 0;
+
 	if (alloc.size > 0) {
 		switch (alloc.alloc)  {
             // Regular allocation 
 			case CoyoteAllocType::REG : {
                 DBG1("cThread: Obtain regular memory"); 
 				mem = aligned_alloc(PAGE_SIZE, alloc.size);
+                bindNumaNode(mem, alloc.size, node, strict_node);
 				userMap(mem, alloc.size);
 				break;
             }
@@ -402,6 +804,7 @@ void* cThread::getMem(CoyoteAlloc&& alloc) {
                     std::cerr << "ERROR: cThread::getMem() - Failed to allocate transparent hugepages!" << std::endl;;
                     return nullptr;
                 }
+                bindNumaNode(mem, alloc.size, node, strict_node);
                 userMap(mem, alloc.size);
                 break;
             }
@@ -410,6 +813,7 @@ void* cThread::getMem(CoyoteAlloc&& alloc) {
             case CoyoteAllocType::HPF : {
                 DBG1("cThread: Obtain huge page memory"); 
                 mem = mmap(NULL, alloc.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                bindNumaNode(mem, alloc.size, node, strict_node);
                 userMap(mem, alloc.size);
 			    break;
             }
@@ -468,6 +872,7 @@ void* cThread::getMem(CoyoteAlloc&& alloc) {
                 tmp[0] = alloc.gpu_dmabuf_fd;
                 tmp[1] = reinterpret_cast<uint64_t>(memNonAligned);
                 tmp[2] = static_cast<uint64_t>(ctid);
+                statAdd(counters.n_map_ioctls);
                 if (ioctl(fd, IOCTL_MAP_DMABUF, &tmp)) {
                     hsa_amd_portable_close_dmabuf(alloc.gpu_dmabuf_fd);
                     hsa_memory_free(memNonAligned);
@@ -504,6 +909,7 @@ void* cThread::getMem(CoyoteAlloc&& alloc) {
 }
 
 void cThread::freeMem(void* vaddr) {
+    TRACE_SCOPE(cTraceEvent::FREE_MEM, ctid, reinterpret_cast<uint64_t>(vaddr), 0);
     DBG1("cThread: Releasing memory at vaddr " << vaddr);
 
 	if (mapped_pages.find(vaddr) != mapped_pages.end()) {
@@ -531,6 +937,7 @@ void cThread::freeMem(void* vaddr) {
                 uint64_t tmp[MAX_USER_ARGS];
                 tmp[0] = reinterpret_cast<uint64_t>(mapped.mem);
                 tmp[1] = static_cast<uint64_t>(ctid);
+                statAdd(counters.n_unmap_ioctls);
                 if (ioctl(fd, IOCTL_UNMAP_DMABUF, &tmp)) {
                     throw std::runtime_error("ERROR: ioctl_unmap_dmabuf() failed");
                 }
@@ -563,14 +970,118 @@ void cThread::freeMem(void* vaddr) {
 }
 
 void cThread::setCSR(uint64_t val, uint32_t offs) {
+    if (uisr) {
+        startEventThread();
+    }
+    statAdd(counters.n_csr_writes);
     ctrl_reg[offs] = val; 
 }
 
 uint64_t cThread::getCSR(uint32_t offs) const {
+    statAdd(counters.n_csr_reads);
     return ctrl_reg[offs];
 }
 
-void cThread::invoke(CoyoteOper oper, syncSg sg) {
+void cThread::setCSRs(uint32_t offs, const uint64_t *vals, uint32_t n) {
+    if (uisr) {
+        startEventThread();
+    }
+    statAdd(counters.n_csr_writes, n);
+    uint32_t i = 0;
+
+    #ifdef EN_AVX
+    if (fcnfg.en_avx) {
+        // Registers before the first 32-byte aligned group
+        for (; i < n && (offs + i) % 4 != 0; i++) {
+            ctrl_reg[offs + i] = vals[i];
+        }
+
+        for (; i + 4 <= n; i += 4) {
+            *((volatile __m256i*) &ctrl_reg[offs + i]) = _mm256_loadu_si256((const __m256i*) &vals[i]);
+        }
+    }
+    #endif
+
+    for (; i < n; i++) {
+        ctrl_reg[offs + i] = vals[i];
+    }
+
+    _mm_sfence();
+}
+
+void cThread::setCSRs(uint32_t offs, const std::vector<uint64_t> &vals) {
+    setCSRs(offs, vals.data(), vals.size());
+}
+
+void cThread::getCSRs(uint32_t offs, uint64_t *vals, uint32_t n) const {
+    statAdd(counters.n_csr_reads, n);
+    uint32_t i = 0;
+
+    #ifdef EN_AVX
+    if (fcnfg.en_avx) {
+        for (; i < n && (offs + i) % 4 != 0; i++) {
+            vals[i] = ctrl_reg[offs + i];
+        }
+
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_si256((__m256i*) &vals[i], *((volatile __m256i*) &ctrl_reg[offs + i]));
+        }
+    }
+    #endif
+
+    for (; i < n; i++) {
+        vals[i] = ctrl_reg[offs + i];
+    }
+}
+
+void cThread::setChunkSize(uint32_t chunk_size) {
+    if (chunk_size == 0 || chunk_size > MAX_TRANSFER_SIZE) {
+        throw std::runtime_error("ERROR: cThread::setChunkSize() - chunk size must be non-zero and at most 128MB, exiting...");
+    }
+    this->chunk_size = chunk_size;
+}
+
+uint32_t cThread::getChunkSize() const { return chunk_size; }
+
+void cThread::setRegCache(bool enable, uint64_t budget) {
+    DBG1("cThread: Setting registration cache to " << enable << " with budget " << budget);
+    reg_cache.setEnabled(enable, budget);
+}
+
+void cThread::invalidateRegCache(const void *addr, uint64_t len) { reg_cache.invalidate(addr, len); }
+
+cRegCacheStats cThread::getRegCacheStats() { return reg_cache.getStats(); }
+
+cThreadStats cThread::getStats() {
+    cThreadStats stats;
+    stats.vfid = vfid;
+    stats.ctid = ctid;
+    counters.snapshot(stats);
+    stats.reg_cache = reg_cache.getStats();
+    return stats;
+}
+
+bool cThread::pinToDevice() {
+    if (local_cpus.empty()) {
+        DBG1("cThread: Local CPUs of the device are unknown; threads not pinned");
+        return false;
+    }
+
+    setThreadAffinity(pthread_self(), local_cpus, "calling thread");
+
+    // The user interrupt thread is started lazily, so the CPUs are also stored and applied in startEventThread()
+    std::lock_guard<std::mutex> lock(event_mtx);
+    event_cpus = local_cpus;
+    if (event_thread.joinable()) {
+        setThreadAffinity(event_thread.native_handle(), event_cpus, "user interrupt thread");
+    }
+
+    return true;
+}
+
+int32_t cThread::getNumaNode() const { return numa_node; }
+
+cmplToken cThread::invoke(CoyoteOper oper, syncSg sg) {
     DBG1("cThread: Call invoke for a sync/offload operation with address " << sg.addr << ", length " << sg.len);
 
     // Argument checks
@@ -582,34 +1093,42 @@ void cThread::invoke(CoyoteOper oper, syncSg sg) {
         throw std::runtime_error("ERROR: cThread::invoke() called for a sync/offload operation,but the shell was not synthesized with card memory support, exiting...");
     }
 
-    if (sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
-    }
+    // Register the buffer, if it's not mapped yet and the registration cache is enabled
+    reg_cache.acquire(sg.addr, sg.len);
 
     // Trigger the operation
-    if (oper == CoyoteOper::LOCAL_OFFLOAD) {
-        uint64_t tmp[MAX_USER_ARGS];
-        tmp[0] = reinterpret_cast<uint64_t>(sg.addr);
-        tmp[1] = reinterpret_cast<uint64_t>(sg.len);
-        tmp[2] = ctid;
-        if (ioctl(fd, IOCTL_OFFLOAD_REQ, &tmp)) {
-            throw std::runtime_error("ERROR: IOCTL_OFFLOAD_REQ failed");
-        }  
-    } else if (oper == CoyoteOper::LOCAL_SYNC) {
+    auto post_req = [&](const syncSg &req) {
         uint64_t tmp[MAX_USER_ARGS];
-        tmp[0] = reinterpret_cast<uint64_t>(sg.addr);
-        tmp[1] = reinterpret_cast<uint64_t>(sg.len);
+        tmp[0] = reinterpret_cast<uint64_t>(req.addr);
+        tmp[1] = reinterpret_cast<uint64_t>(req.len);
         tmp[2] = ctid;
-        if (ioctl(fd, IOCTL_SYNC_REQ, &tmp)) {
-            throw std::runtime_error("ERROR: IOCTL_SYNC_REQ failed");
+        if (oper == CoyoteOper::LOCAL_OFFLOAD) {
+            if (ioctl(fd, IOCTL_OFFLOAD_REQ, &tmp)) {
+                throw std::runtime_error("ERROR: IOCTL_OFFLOAD_REQ failed");
+            }  
+        } else {
+            if (ioctl(fd, IOCTL_SYNC_REQ, &tmp)) {
+                throw std::runtime_error("ERROR: IOCTL_SYNC_REQ failed");
+            }
+        }
+        statAdd(counters.n_cmds[static_cast<uint32_t>(oper)]);
+        statAdd(counters.n_bytes[static_cast<uint32_t>(oper)], req.len);
+    };
+
+    // Split long transfers into chunks; syncs and offloads are blocking, so the chunks are simply issued one after the other
+    statAdd(counters.n_ops[static_cast<uint32_t>(oper)]);
+    if (sg.len > chunk_size) {
+        for (uint64_t offs = 0; offs < sg.len; offs += chunk_size) {
+            post_req({ .addr = reinterpret_cast<char *>(sg.addr) + offs, .len = std::min(sg.len - offs, static_cast<uint64_t>(chunk_size)) });
         }
     } else {
-        std::cerr << "ERROR: cThread::invoke() called with an unsupported operation type; returning..." << std::endl;
-        return;
+        post_req(sg);
     }
+
+    return CMPL_TOKEN_NONE;
 }
 
-void cThread::invoke(CoyoteOper oper, localSg sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, localSg sg, bool last) {
     // Argument checks
     DBG1("cThread: Call invoke for a one-side local operation with address " << sg.addr << ", length " << sg.len);
 
@@ -621,48 +1140,23 @@ void cThread::invoke(CoyoteOper oper, localSg sg, bool last) {
         throw std::runtime_error("ERROR: cThread::invoke() called for a local operation, but the shell was not synthesized with streams from host memory, exiting...");
     }
 
-    if (sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
-    }
+    // Register the buffer, if it's not mapped yet and the registration cache is enabled
+    reg_cache.acquire(&sg, 1);
 
-    // Trigger the operation
-    uint64_t addr_cmd_src, addr_cmd_dst;
-    uint64_t ctrl_cmd_src, ctrl_cmd_dst;
+    // Trigger the operation; transfers longer than the chunk size are split into multiple commands
     if (oper == CoyoteOper::LOCAL_READ) {
-        ctrl_cmd_src =
-            ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
-            ((sg.dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
-            (last ? CTRL_LAST : 0x0) |
-            ((sg.stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
-            (CTRL_START) | 
-            (0x0) | 
-            (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
-        
-        addr_cmd_src = reinterpret_cast<uint64_t>(sg.addr);
-
-        postCmd(addr_cmd_dst, ctrl_cmd_dst, addr_cmd_src, ctrl_cmd_src);
+        return submitCmds(oper, last, [&]() { postLocalCmds(&sg, 1, nullptr, 0, last); });
 
     } else if (oper == CoyoteOper::LOCAL_WRITE) {
-        ctrl_cmd_dst =
-            ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
-            ((sg.dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
-            (last ? CTRL_LAST : 0x0) |
-            ((sg.stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
-            (CTRL_START) | 
-            (0x0) | 
-            (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
-
-        addr_cmd_dst = reinterpret_cast<uint64_t>(sg.addr);
-
-        postCmd(addr_cmd_dst, ctrl_cmd_dst, addr_cmd_src, ctrl_cmd_src);
+        return submitCmds(oper, last, [&]() { postLocalCmds(nullptr, 0, &sg, 1, last); });
 
     } else {
         std::cerr << "ERROR: cThread::invoke() called with an unsupported operation type; returning..." << std::endl;
-        return;
+        return CMPL_TOKEN_NONE;
     }
 }
 
-void cThread::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last) {
     // Argument checks
     DBG1(
         "cThread: Call invoke for a two-sided local operation with source address " 
@@ -678,42 +1172,79 @@ void cThread::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg, bool last)
         throw std::runtime_error("ERROR: cThread::invoke() called for a local operation but the shell was not synthesized with streams from host memory, exiting...");
     }
 
-    if (src_sg.len > MAX_TRANSFER_SIZE || dst_sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
-    }
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    reg_cache.acquire(&src_sg, 1);
+    reg_cache.acquire(&dst_sg, 1);
 
-    // Trigger the operation
+    // Trigger the operation; transfers longer than the chunk size are split into multiple commands
     if (oper == CoyoteOper::LOCAL_TRANSFER) {
-        uint64_t ctrl_cmd_src =
-            ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
-            ((src_sg.dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
-            (last ? CTRL_LAST : 0x0) |
-            ((src_sg.stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
-            (CTRL_START) | 
-            (0x0) | 
-            (static_cast<uint64_t>(src_sg.len) << CTRL_LEN_OFFS);
-
-        uint64_t ctrl_cmd_dst =
-            ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
-            ((dst_sg.dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
-            (last ? CTRL_LAST : 0x0) |
-            ((dst_sg.stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
-            (CTRL_START) | 
-            (0x0) | 
-            (static_cast<uint64_t>(dst_sg.len) << CTRL_LEN_OFFS);
-
-        uint64_t addr_cmd_src = reinterpret_cast<uint64_t>(src_sg.addr);
-        uint64_t addr_cmd_dst = reinterpret_cast<uint64_t>(dst_sg.addr);
-
-        postCmd(addr_cmd_dst, ctrl_cmd_dst, addr_cmd_src, ctrl_cmd_src);
+        return submitCmds(oper, last, [&]() { postLocalCmds(&src_sg, 1, &dst_sg, 1, last); });
 
     } else {
         std::cerr << "ERROR: cThread::invoke() called with an unsupported operation type; returning..." << std::endl;
-        return;
+        return CMPL_TOKEN_NONE;
     }
 }
 
-void cThread::invoke(CoyoteOper oper, rdmaSg sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, const sgList &sg_list, bool last) {
+    DBG1("cThread: Call invoke for a one-sided local operation with a scatter-gather list of " << sg_list.size() << " entries");
+
+    // Argument checks
+    if (oper != CoyoteOper::LOCAL_READ && oper != CoyoteOper::LOCAL_WRITE) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with a single sgList, but the operation is not a LOCAL_READ or LOCAL_WRITE; exiting...");
+    }
+
+    if (!fcnfg.en_strm) {
+        throw std::runtime_error("ERROR: cThread::invoke() called for a local operation, but the shell was not synthesized with streams from host memory, exiting...");
+    }
+
+    if (sg_list.empty()) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with an empty sgList, exiting...");
+    }
+
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    reg_cache.acquire(sg_list.data(), sg_list.size());
+
+    // Trigger the operation; all the entries form one logical packet, so only the final chunk of the final entry is flagged as last
+    return submitCmds(oper, last, [&]() {
+        if (oper == CoyoteOper::LOCAL_READ) {
+            postLocalCmds(sg_list.data(), sg_list.size(), nullptr, 0, last);
+        } else {
+            postLocalCmds(nullptr, 0, sg_list.data(), sg_list.size(), last);
+        }
+    });
+}
+
+cmplToken cThread::invoke(CoyoteOper oper, const sgList &src_list, const sgList &dst_list, bool last) {
+    DBG1(
+        "cThread: Call invoke for a two-sided local operation with scatter-gather lists of " 
+        << src_list.size() << " source entries and " << dst_list.size() << " destination entries"
+    );
+
+    // Argument checks
+    if (oper != CoyoteOper::LOCAL_TRANSFER) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with two sgLists, but the operation is not a LOCAL_TRANSFER; exiting...");
+    }
+
+    if (!fcnfg.en_strm) {
+        throw std::runtime_error("ERROR: cThread::invoke() called for a local operation but the shell was not synthesized with streams from host memory, exiting...");
+    }
+
+    if (src_list.empty() || dst_list.empty()) {
+        throw std::runtime_error("ERROR: cThread::invoke() called with an empty sgList, exiting...");
+    }
+
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    reg_cache.acquire(src_list.data(), src_list.size());
+    reg_cache.acquire(dst_list.data(), dst_list.size());
+
+    // Trigger the operation
+    return submitCmds(oper, last, [&]() { 
+        postLocalCmds(src_list.data(), src_list.size(), dst_list.data(), dst_list.size(), last); 
+    });
+}
+
+cmplToken cThread::invoke(CoyoteOper oper, rdmaSg sg, bool last) {
     // Argument checks
     DBG1("cThread: Call invoke for a RDMA operation with length " << sg.len);
 
@@ -725,10 +1256,6 @@ void cThread::invoke(CoyoteOper oper, rdmaSg sg, bool last) {
         throw std::runtime_error("ERROR: cThread::invoke() called for an RDMA operation but the shell was not synthesized with RDMA support, exiting...");
     }
 
-    if (sg.len > MAX_TRANSFER_SIZE) {
-        throw std::runtime_error("ERROR: cThread::invoke() - transfers over 128MB are currently not supported in Coyote, exiting...");
-    }
-
     // Trigger the operation
     if (qpair->local.ip_addr == qpair->remote.ip_addr) {
         DBG1("cThread: remote and local node for RDMA operation are identical; calling memcpy");
@@ -736,44 +1263,29 @@ void cThread::invoke(CoyoteOper oper, rdmaSg sg, bool last) {
         void *local_addr = (void*) ((uint64_t) qpair->local.vaddr + sg.local_offs);
         void *remote_addr = (void*) ((uint64_t) qpair->remote.vaddr + sg.remote_offs);
         memcpy(remote_addr, local_addr, sg.len);
+        return CMPL_TOKEN_NONE;
 
     } else {
-        // Local command and address
-        uint64_t ctrl_cmd_l =
-            (((static_cast<uint64_t>(oper) - REMOTE_OFFS_OPS) & CTRL_OPCODE_MASK) << CTRL_OPCODE_OFFS) |
-            ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
-            ((sg.local_dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
-            (last ? CTRL_LAST : 0x0) |
-            ((sg.local_stream & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
-            (0x0) | 
-            (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
-        
-        uint64_t addr_cmd_l = static_cast<uint64_t>((uint64_t) qpair->local.vaddr + sg.local_offs);
-
-        // Remote command and address
-        uint64_t ctrl_cmd_r =                    
-            (((static_cast<uint64_t>(oper) - REMOTE_OFFS_OPS) & CTRL_OPCODE_MASK) << CTRL_OPCODE_OFFS) |
-            ((ctid & CTRL_PID_MASK) << CTRL_PID_OFFS) |
-            ((sg.remote_dest & CTRL_DEST_MASK) << CTRL_DEST_OFFS) |
-            (last ? CTRL_LAST : 0x0) |
-            ((STRM_RDMA & CTRL_STRM_MASK) << CTRL_STRM_OFFS) | 
-            (CTRL_START) |
-            (0x0) | 
-            (static_cast<uint64_t>(sg.len) << CTRL_LEN_OFFS);
-
-        uint64_t addr_cmd_r = static_cast<uint64_t>((uint64_t) qpair->remote.vaddr + sg.remote_offs); 
-
-        // Order - based on the distinction between Read and Write, determine what is source and what is destination 
-        uint64_t ctrl_cmd_src = isRemoteRead(oper) ? ctrl_cmd_r : ctrl_cmd_l;
-        uint64_t addr_cmd_src = isRemoteRead(oper) ? addr_cmd_r : addr_cmd_l;
-        uint64_t ctrl_cmd_dst = isRemoteRead(oper) ? ctrl_cmd_l : ctrl_cmd_r;
-        uint64_t addr_cmd_dst = isRemoteRead(oper) ? addr_cmd_l : addr_cmd_r;
-
-        postCmd(addr_cmd_dst, ctrl_cmd_dst, addr_cmd_src, ctrl_cmd_src);
+        // Transfers longer than the chunk size are split into multiple commands, with increasing offsets
+        uint32_t n_cmds = getNumChunks(sg.len);
+        return submitCmds(oper, last, [&]() {
+            cmdDesc cmds[CMD_FIFO_DEPTH];
+            for (uint32_t i = 0; i < n_cmds; i += CMD_FIFO_DEPTH) {
+                uint32_t n_group = std::min(n_cmds - i, static_cast<uint32_t>(CMD_FIFO_DEPTH));
+                for (uint32_t j = 0; j < n_group; j++) {
+                    rdmaSg chunk = sg;
+                    chunk.local_offs += static_cast<uint64_t>(i + j) * chunk_size;
+                    chunk.remote_offs += static_cast<uint64_t>(i + j) * chunk_size;
+                    chunk.len = std::min(sg.len - static_cast<uint64_t>(i + j) * chunk_size, static_cast<uint64_t>(chunk_size));
+                    cmds[j] = rdmaCmd(oper, chunk, last && (i + j == n_cmds - 1));
+                }
+                postCmds(cmds, n_group);
+            }
+        });
     }
 }
 
-void cThread::invoke(CoyoteOper oper, tcpSg sg, bool last) {
+cmplToken cThread::invoke(CoyoteOper oper, tcpSg sg, bool last) {
     // Argument checks
     DBG1("cThread: Call invoke for a TCP operation with length " << sg.len);
 
@@ -802,7 +1314,113 @@ void cThread::invoke(CoyoteOper oper, tcpSg sg, bool last) {
     uint64_t addr_cmd_src = 0;
     uint64_t addr_cmd_dst = 0;
 
-    postCmd(addr_cmd_dst, ctrl_cmd_dst, addr_cmd_src, ctrl_cmd_src);
+    return submitCmds(oper, last, [&]() { postCmd(addr_cmd_dst, ctrl_cmd_dst, addr_cmd_src, ctrl_cmd_src); });
+}
+
+cmplToken cThread::invokeBatch(CoyoteOper oper, const std::vector<localSg> &sg_list, bool last) {
+    DBG1("cThread: Call invokeBatch for " << sg_list.size() << " one-sided local operations");
+
+    // Argument checks; done once for the entire batch
+    if (!isLocalRead(oper) && !isLocalWrite(oper)) {
+        throw std::runtime_error("ERROR: cThread::invokeBatch() called with localSg flags, but the operation is not a LOCAL_READ or LOCAL_WRITE; exiting...");
+    }
+
+    if (oper == CoyoteOper::LOCAL_TRANSFER) {
+        throw std::runtime_error("ERROR: cThread::invokeBatch() called for a LOCAL_TRANSFER with one-sided localSg entries; use pairs of localSg instead, exiting...");
+    }
+
+    if (!fcnfg.en_strm) {
+        throw std::runtime_error("ERROR: cThread::invokeBatch() called for a local operation, but the shell was not synthesized with streams from host memory, exiting...");
+    }
+
+    for (const localSg &sg : sg_list) {
+        if (sg.len > MAX_TRANSFER_SIZE) {
+            throw std::runtime_error("ERROR: cThread::invokeBatch() - transfers over 128MB are currently not supported in Coyote, exiting...");
+        }
+    }
+
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    reg_cache.acquire(sg_list.data(), sg_list.size());
+
+    // Only the final command in the batch can be flagged as last, so the batch gets a single token
+    return submitCmds(oper, last && !sg_list.empty(), [&]() {
+        // Encode the commands in chunks of at most CMD_FIFO_DEPTH entries and stream them back-to-back
+        cmdDesc cmds[CMD_FIFO_DEPTH];
+        for (size_t i = 0; i < sg_list.size(); i += CMD_FIFO_DEPTH) {
+            uint32_t n_cmds = std::min(sg_list.size() - i, static_cast<size_t>(CMD_FIFO_DEPTH));
+            for (uint32_t j = 0; j < n_cmds; j++) {
+                const localSg &sg = sg_list[i + j];
+                bool is_last = last && (i + j == sg_list.size() - 1);
+                if (oper == CoyoteOper::LOCAL_READ) {
+                    cmds[j] = { .addr_dst = 0, .ctrl_dst = 0, .addr_src = reinterpret_cast<uint64_t>(sg.addr), .ctrl_src = localCtrlCmd(sg, is_last) };
+                } else {
+                    cmds[j] = { .addr_dst = reinterpret_cast<uint64_t>(sg.addr), .ctrl_dst = localCtrlCmd(sg, is_last), .addr_src = 0, .ctrl_src = 0 };
+                }
+            }
+            postCmds(cmds, n_cmds);
+        }
+    });
+}
+
+cmplToken cThread::invokeBatch(CoyoteOper oper, const std::vector<std::pair<localSg, localSg>> &sg_list, bool last) {
+    DBG1("cThread: Call invokeBatch for " << sg_list.size() << " two-sided local operations");
+
+    // Argument checks; done once for the entire batch
+    if (!(isLocalRead(oper) && isLocalWrite(oper))) {
+        throw std::runtime_error("ERROR: cThread::invokeBatch() called with pairs of localSg flags, but the operation is not a LOCAL_TRANSFER; exiting...");
+    }
+
+    if (!fcnfg.en_strm) {
+        throw std::runtime_error("ERROR: cThread::invokeBatch() called for a local operation but the shell was not synthesized with streams from host memory, exiting...");
+    }
+
+    for (const auto &sg : sg_list) {
+        if (sg.first.len > MAX_TRANSFER_SIZE || sg.second.len > MAX_TRANSFER_SIZE) {
+            throw std::runtime_error("ERROR: cThread::invokeBatch() - transfers over 128MB are currently not supported in Coyote, exiting...");
+        }
+    }
+
+    // Register the buffers, if they're not mapped yet and the registration cache is enabled
+    if (reg_cache.isEnabled()) {
+        for (const auto &sg : sg_list) {
+            reg_cache.acquire(&sg.first, 1);
+            reg_cache.acquire(&sg.second, 1);
+        }
+    }
+
+    // Only the final command in the batch can be flagged as last, so the batch gets a single token
+    return submitCmds(oper, last && !sg_list.empty(), [&]() {
+        // Encode the commands in chunks of at most CMD_FIFO_DEPTH entries and stream them back-to-back
+        cmdDesc cmds[CMD_FIFO_DEPTH];
+        for (size_t i = 0; i < sg_list.size(); i += CMD_FIFO_DEPTH) {
+            uint32_t n_cmds = std::min(sg_list.size() - i, static_cast<size_t>(CMD_FIFO_DEPTH));
+            for (uint32_t j = 0; j < n_cmds; j++) {
+                const localSg &src_sg = sg_list[i + j].first;
+                const localSg &dst_sg = sg_list[i + j].second;
+                bool is_last = last && (i + j == sg_list.size() - 1);
+                cmds[j] = {
+                    .addr_dst = reinterpret_cast<uint64_t>(dst_sg.addr), .ctrl_dst = localCtrlCmd(dst_sg, is_last),
+                    .addr_src = reinterpret_cast<uint64_t>(src_sg.addr), .ctrl_src = localCtrlCmd(src_sg, is_last)
+                };
+            }
+            postCmds(cmds, n_cmds);
+        }
+    });
+}
+
+cFuture cThread::invokeAsync(CoyoteOper oper, localSg sg) {
+    cmplToken token = invoke(oper, sg, true);
+    return cReactor::getInstance().watch(this, token);
+}
+
+cFuture cThread::invokeAsync(CoyoteOper oper, localSg src_sg, localSg dst_sg) {
+    cmplToken token = invoke(oper, src_sg, dst_sg, true);
+    return cReactor::getInstance().watch(this, token);
+}
+
+cFuture cThread::invokeAsync(CoyoteOper oper, rdmaSg sg) {
+    cmplToken token = invoke(oper, sg, true);
+    return cReactor::getInstance().watch(this, token);
 }
 
 uint32_t cThread::checkCompleted(CoyoteOper coper) const {
@@ -864,8 +1482,84 @@ uint32_t cThread::checkCompleted(CoyoteOper coper) const {
     }
 }
 
+bool cThread::waitCompleted(CoyoteOper oper, uint32_t count, std::chrono::nanoseconds timeout) {
+    DBG1("cThread: Called waitCompleted for " << count << " completions");
+    TRACE_SCOPE(cTraceEvent::WAIT, ctid, static_cast<uint64_t>(oper), count);
+    statAdd(counters.n_waits);
+    if (uisr) {
+        startEventThread();
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto deadline = timeout >= std::chrono::steady_clock::time_point::max() - start_time ? 
+        std::chrono::steady_clock::time_point::max() : start_time + timeout;
+
+    // Spin for a short time first; most short operations complete here, without the latency of a wakeup
+    while (true) {
+        if (checkCompleted(oper) >= count) {
+            return true;
+        }
+
+        auto curr_time = std::chrono::steady_clock::now();
+        if (curr_time >= deadline) {
+            statAdd(counters.n_timeouts);
+            return false;
+        }
+
+        if (curr_time - start_time >= wait_spin) {
+            break;
+        }
+        cpuRelax();
+    }
+
+    /*
+     * Block until woken up by a user interrupt (signalled by the eventHandler) or until the timer expires.
+     * DMA completions don't raise an interrupt on their own, so the timer bounds the detection latency; 
+     * it's doubled after every unsuccessful check, so long waits cost only a few wakeups per millisecond.
+     */
+    statAdd(counters.n_sleeps);
+    struct pollfd poll_fd = { .fd = wait_efd, .events = POLLIN, .revents = 0 };
+    std::chrono::nanoseconds sleep_time(WAIT_MIN_SLEEP_TIME);
+    while (true) {
+        auto sleep_start = std::chrono::steady_clock::now();
+        std::chrono::nanoseconds curr_sleep = std::min(sleep_time, std::chrono::nanoseconds(deadline - sleep_start));
+        struct timespec sleep_spec = { 
+            .tv_sec = static_cast<time_t>(curr_sleep.count() / 1000000000L), .tv_nsec = static_cast<long>(curr_sleep.count() % 1000000000L) 
+        };
+
+        if (ppoll(&poll_fd, 1, &sleep_spec, nullptr) > 0) {
+            eventfd_t val;
+            eventfd_read(wait_efd, &val);
+            statAdd(counters.n_irq_wakeups);
+        }
+
+        auto sleep_end = std::chrono::steady_clock::now();
+        uint64_t slept_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_end - sleep_start).count();
+        statAdd(counters.sleep_ns, slept_ns);
+
+        if (checkCompleted(oper) >= count) {
+            statAdd(counters.final_sleep_ns, slept_ns);
+            statMax(counters.max_final_sleep_ns, slept_ns);
+            return true;
+        }
+
+        if (sleep_end >= deadline) {
+            statAdd(counters.n_timeouts);
+            return false;
+        }
+
+        sleep_time = std::min(2 * sleep_time, std::chrono::nanoseconds(WAIT_MAX_SLEEP_TIME));
+    }
+}
+
+void cThread::setWaitSpin(std::chrono::nanoseconds spin) { wait_spin = spin; }
+
+cmplWaitStats cThread::getWaitStats() const { return counters.getWaitStats(); }
+
 void cThread::clearCompleted() {
     DBG1("cThread: Called clearCompleted"); 
+
+    cmpl_queue.clear();
     
     if (fcnfg.en_wb) {
         for (int i = 0; i < N_WBACKS; i++) {
@@ -885,6 +1579,68 @@ void cThread::clearCompleted() {
     #endif
 }
 
+bool cThread::isCompleted(cmplToken token) {
+    int32_t cls = cCmplQueue::getTokenClass(token);
+    if (cls < 0) {
+        return true;
+    }
+
+    // In multi-producer mode, tokens are issued concurrently, so the stateless comparison against the counter is used instead
+    bool completed;
+    if (submit_queue) {
+        completed = cCmplQueue::isCompleted(token, checkCompleted(cCmplQueue::getClassOper(cls)));
+    } else {
+        cmpl_queue.update(cls, checkCompleted(cCmplQueue::getClassOper(cls)));
+        completed = cmpl_queue.isCompleted(token);
+    }
+
+    if (completed) {
+        TRACE_INSTANT(cTraceEvent::COMPLETION, ctid, static_cast<uint64_t>(cCmplQueue::getClassOper(cls)), token);
+    }
+    return completed;
+}
+
+uint32_t cThread::pollCompletions(cmplEntry *cmpls, uint32_t n_cmpls) {
+    DBG1("cThread: Called pollCompletions");
+    if (!cmpl_queue.isTracking()) {
+        throw std::runtime_error("ERROR: cThread::pollCompletions() - the completion queue isn't enabled, see setCompletionQueue()");
+    }
+
+    // Only read the counters for classes with outstanding operations, to avoid unnecessary uncached reads
+    auto poll_fn = [&]() {
+        for (uint32_t cls = 0; cls < N_WBACKS; cls++) {
+            if (cmpl_queue.hasPending(cls)) {
+                cmpl_queue.update(cls, checkCompleted(cCmplQueue::getClassOper(cls)));
+            }
+        }
+        return cmpl_queue.poll(cmpls, n_cmpls);
+    };
+
+    // In multi-producer mode, tokens are issued concurrently, so the queue must not be modified by the producers meanwhile
+    uint32_t n_polled = submit_queue ? submit_queue->locked(poll_fn) : poll_fn();
+
+    #ifdef EN_TRACE
+    for (uint32_t i = 0; i < n_polled; i++) {
+        TRACE_INSTANT(cTraceEvent::COMPLETION, ctid, static_cast<uint64_t>(cmpls[i].oper), cmpls[i].token);
+    }
+    #endif
+    return n_polled;
+}
+
+void cThread::setCompletionQueue(bool enable) {
+    DBG1("cThread: Called setCompletionQueue, enable: " << enable);
+    cmpl_queue.setTracking(enable);
+}
+
+void cThread::setMultiProducer(bool enable) {
+    DBG1("cThread: Setting multi-producer submission to " << enable);
+    if (enable && !submit_queue) {
+        submit_queue = std::make_unique<cSubmitQueue>();
+    } else if (!enable) {
+        submit_queue.reset();
+    }
+}
+
 void cThread::doArpLookup(uint32_t ip_addr) {
     DBG3("cThread: Called doArpLookup for IP address " << ip_addr); 
 
@@ -990,6 +1746,10 @@ void cThread::connSync(bool client) {
 }
 
 void* cThread::initRDMA(uint32_t buffer_size, uint16_t port, const char* server_address) {
+    if (uisr) {
+        startEventThread();
+    }
+
     // Served address provided, so this node is the client
     if (server_address) {
         DBG3("cThread: initRDMA called from client side with server address " << server_address);
@@ -1165,7 +1925,12 @@ void cThread::closeConn() {
 void cThread::lock() {
     DBG3("cThread: Called lock");
     if (!lock_acquired) {
-        vlock.lock();
+        if (!vlock) {
+            vlock = std::make_unique<boost::interprocess::named_mutex>(
+                boost::interprocess::open_or_create, ("mutex_dev_" + std::to_string(device) + "_vfpa_" + std::to_string(vfid)).c_str()
+            );
+        }
+        vlock->lock();
         lock_acquired = true;
     }
 }
@@ -1173,11 +1938,18 @@ void cThread::lock() {
 void cThread::unlock() {
     DBG3("cThread: Called unlock");
     if (lock_acquired) {
-        vlock.unlock();
+        vlock->unlock();
         lock_acquired = false;
     }
 }
 
+void cThread::setBackoff(CoyoteBackoff backoff) {
+    DBG1("cThread: Setting command FIFO backoff policy to " << static_cast<int>(backoff));
+    this->backoff = backoff;
+}
+
+cmdStallStats cThread::getStallStats() const { return counters.getStallStats(); }
+
 int32_t cThread::getVfid() const { return vfid;};
 
 int32_t cThread::getCtid() const { return ctid; };
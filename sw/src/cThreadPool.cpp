@@ -0,0 +1,276 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdexcept>
+
+#include "cThreadPool.hpp"
+
+namespace coyote {
+
+cThreadPool::cThreadPool(int32_t vfid, uint32_t n_workers, uint32_t n_streams, pid_t hpid, uint32_t device) {
+    if (n_workers == 0) {
+        throw std::runtime_error("ERROR: cThreadPool - the pool must have at least one worker");
+    }
+
+    this->n_streams = n_streams ? n_streams : n_workers;
+    strm_busy.reset(new std::atomic<bool>[this->n_streams]);
+    for (uint32_t s = 0; s < this->n_streams; s++) {
+        strm_busy[s] = false;
+    }
+
+    for (uint32_t i = 0; i < n_workers; i++) {
+        cthreads.emplace_back(new cThread(vfid, hpid, device));
+        workers.emplace_back(new cPoolWorker());
+    }
+
+    DBG1("cThreadPool: Starting " << n_workers << " workers for " << this->n_streams << " host streams");
+    for (uint32_t i = 0; i < n_workers; i++) {
+        workers[i]->thread = std::thread(&cThreadPool::run, this, i);
+    }
+}
+
+cThreadPool::~cThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mtx);
+        stop = true;
+    }
+    idle_cv.notify_all();
+
+    for (auto &worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // The first cThread owns the memory from getMem(), so it is released last, once all the other cThreads have unmapped it
+    while (!cthreads.empty()) {
+        cthreads.pop_back();
+    }
+}
+
+void* cThreadPool::getMem(CoyoteAlloc&& alloc) {
+    uint32_t size = alloc.size;
+    void *mem = cthreads[0]->getMem(std::move(alloc));
+    if (mem) {
+        for (size_t i = 1; i < cthreads.size(); i++) {
+            cthreads[i]->userMap(mem, size);
+        }
+    }
+    return mem;
+}
+
+void cThreadPool::freeMem(void *vaddr) {
+    for (size_t i = 1; i < cthreads.size(); i++) {
+        cthreads[i]->userUnmap(vaddr);
+    }
+    cthreads[0]->freeMem(vaddr);
+}
+
+void cThreadPool::userMap(void *vaddr, uint32_t len) {
+    for (auto &cthread : cthreads) {
+        cthread->userMap(vaddr, len);
+    }
+}
+
+void cThreadPool::userUnmap(void *vaddr) {
+    for (auto &cthread : cthreads) {
+        cthread->userUnmap(vaddr);
+    }
+}
+
+cFuture cThreadPool::invoke(CoyoteOper oper, localSg sg) {
+    if (oper != CoyoteOper::LOCAL_READ && oper != CoyoteOper::LOCAL_WRITE) {
+        throw std::runtime_error("ERROR: cThreadPool::invoke() called with one sg_entry, but the operation is not LOCAL_READ or LOCAL_WRITE");
+    }
+    return invoke(oper, sg, sg);
+}
+
+cFuture cThreadPool::invoke(CoyoteOper oper, localSg src_sg, localSg dst_sg) {
+    if (!isLocalRead(oper) && !isLocalWrite(oper)) {
+        throw std::runtime_error("ERROR: cThreadPool::invoke() only supports local operations (LOCAL_READ, LOCAL_WRITE, LOCAL_TRANSFER)");
+    }
+    if (src_sg.dest != dst_sg.dest) {
+        throw std::runtime_error("ERROR: cThreadPool::invoke() called with different source and destination streams");
+    }
+    if (src_sg.dest != DEST_ANY && src_sg.dest >= n_streams) {
+        throw std::runtime_error("ERROR: cThreadPool::invoke() called with dest " + std::to_string(src_sg.dest) + ", but the vFPGA only has " + std::to_string(n_streams) + " host streams");
+    }
+
+    uint32_t n_workers = workers.size();
+    uint32_t home = src_sg.dest == DEST_ANY ? next_worker.fetch_add(1, std::memory_order_relaxed) % n_workers : src_sg.dest % n_workers;
+    
+    cPromise promise;
+    n_pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(workers[home]->mtx);
+        workers[home]->queue.push_back({ .oper = oper, .src_sg = src_sg, .dst_sg = dst_sg, .dest = src_sg.dest, .promise = promise });
+        n_queued.fetch_add(1);
+    }
+    notify();
+
+    return promise.getFuture();
+}
+
+bool cThreadPool::take(uint32_t victim, cPoolTask &task) {
+    std::lock_guard<std::mutex> lock(workers[victim]->mtx);
+    std::deque<cPoolTask> &queue = workers[victim]->queue;
+
+    // Streams of the transfers skipped so far; later transfers on those streams must not overtake them
+    std::vector<bool> skipped(n_streams, false);
+
+    for (auto it = queue.begin(); it != queue.end(); it++) {
+        uint32_t dest = it->dest;
+
+        if (dest == DEST_ANY) {
+            for (uint32_t s = 0; s < n_streams; s++) {
+                bool idle = false;
+                if (!skipped[s] && strm_busy[s].compare_exchange_strong(idle, true)) {
+                    dest = s;
+                    break;
+                }
+            }
+
+            // All streams are busy, so no other transfer can run either
+            if (dest == DEST_ANY) {
+                return false;
+            }
+        } else {
+            bool idle = false;
+            if (skipped[dest] || !strm_busy[dest].compare_exchange_strong(idle, true)) {
+                skipped[dest] = true;
+                continue;
+            }
+        }
+
+        task = std::move(*it);
+        task.dest = task.src_sg.dest = task.dst_sg.dest = dest;
+        queue.erase(it);
+        n_queued.fetch_sub(1);
+        return true;
+    }
+
+    return false;
+}
+
+void cThreadPool::execute(uint32_t id, cPoolTask &task) {
+    cThread *cthread = cthreads[id].get();
+
+    try {
+        cmplToken token = task.oper == CoyoteOper::LOCAL_TRANSFER ? 
+            cthread->invoke(task.oper, task.src_sg, task.dst_sg) : cthread->invoke(task.oper, task.src_sg);
+
+        // DMA completions don't raise an interrupt, so the worker polls for them; this occupies one core per busy worker
+        while (!cthread->isCompleted(token)) {
+            cpuRelax();
+        }
+        task.promise.setReady();
+    } catch (...) {
+        task.promise.setException(std::current_exception());
+    }
+
+    strm_busy[task.dest].store(false);
+    workers[id]->n_executed.fetch_add(1, std::memory_order_relaxed);
+
+    // The released stream makes at most one queued transfer runnable; this worker looks for it itself on its next 
+    // iteration, but wakes up one more worker, in case it takes a different transfer first
+    if (n_queued.load() > 0) {
+        notify();
+    }
+
+    if (n_pending.fetch_sub(1) == 1) {
+        // Last transfer completed; wake up drain() and, if the pool is being destroyed, all workers, so that they exit
+        std::lock_guard<std::mutex> lock(idle_mtx);
+        drain_cv.notify_all();
+        if (stop) {
+            idle_cv.notify_all();
+        }
+    }
+}
+
+void cThreadPool::notify() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mtx);
+        version++;
+    }
+    idle_cv.notify_one();
+}
+
+void cThreadPool::run(uint32_t id) {
+    uint32_t n_workers = workers.size();
+
+    while (true) {
+        uint64_t seen;
+        {
+            std::lock_guard<std::mutex> lock(idle_mtx);
+            if (stop && n_pending.load() == 0) {
+                return;
+            }
+            seen = version;
+        }
+
+        // Own queue first, then steal from the other workers, starting with the next one
+        cPoolTask task;
+        bool found = take(id, task);
+        for (uint32_t k = 1; k < n_workers && !found; k++) {
+            if (take((id + k) % n_workers, task)) {
+                workers[id]->n_stolen.fetch_add(1, std::memory_order_relaxed);
+                found = true;
+            }
+        }
+
+        if (found) {
+            execute(id, task);
+        } else {
+            std::unique_lock<std::mutex> lock(idle_mtx);
+            idle_cv.wait(lock, [&] { return version != seen || (stop && n_pending.load() == 0); });
+        }
+    }
+}
+
+void cThreadPool::drain() {
+    std::unique_lock<std::mutex> lock(idle_mtx);
+    drain_cv.wait(lock, [&] { return n_pending.load() == 0; });
+}
+
+uint32_t cThreadPool::getNumWorkers() const {
+    return workers.size();
+}
+
+cThread* cThreadPool::getThread(uint32_t i) const {
+    return cthreads.at(i).get();
+}
+
+cThreadPoolStats cThreadPool::getStats() const {
+    cThreadPoolStats stats;
+    for (auto &worker : workers) {
+        stats.n_executed += worker->n_executed.load(std::memory_order_relaxed);
+        stats.n_stolen += worker->n_stolen.load(std::memory_order_relaxed);
+    }
+    stats.n_pending = n_pending.load();
+    return stats;
+}
+
+}
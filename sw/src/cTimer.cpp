@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string>
+#include <thread>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include "cTimer.hpp"
+
+namespace coyote {
+
+/// Reads the first word of a (sysfs) file; returns an empty string if the file doesn't exist
+static std::string readSysfs(const std::string &path) {
+    std::ifstream file(path);
+    std::string value;
+    file >> value;
+    return value;
+}
+
+/// Prints a warning for every condition that makes the timings unreliable or noisy
+static void checkTimerConditions() {
+    #if defined(__x86_64__) || defined(__i386__)
+    if (!cTimer::isInvariant()) {
+        std::cerr << "WARNING: cTimer - the CPU's time-stamp counter is not invariant; its rate follows the CPU frequency, so the timings may be inaccurate" << std::endl;
+    }
+    #endif
+
+    std::string governor = readSysfs("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    if (!governor.empty() && governor != "performance") {
+        std::cerr << "WARNING: cTimer - CPU frequency scaling is enabled (governor: " << governor << "); "
+                  << "for stable timings, set the governor to performance" << std::endl;
+    }
+
+    if (readSysfs("/sys/devices/system/cpu/intel_pstate/no_turbo") == "0" || readSysfs("/sys/devices/system/cpu/cpufreq/boost") == "1") {
+        std::cerr << "WARNING: cTimer - CPU turbo boost is enabled; the timings may vary with the CPU's temperature and load" << std::endl;
+    }
+}
+
+/// Calibrates the timer against the steady clock; the steady clock is read between two timestamps, to bound the error of every reference point
+static double calibrateTicksPerNs() {
+    checkTimerConditions();
+
+    #if defined(__x86_64__) || defined(__i386__)
+    auto reference = [](uint64_t &ticks, std::chrono::steady_clock::time_point &time) {
+        uint64_t before = cTimer::start();
+        time = std::chrono::steady_clock::now();
+        uint64_t after = cTimer::stop();
+        ticks = before + (after - before) / 2;
+    };
+
+    uint64_t begin_ticks, end_ticks;
+    std::chrono::steady_clock::time_point begin_time, end_time;
+    reference(begin_ticks, begin_time);
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIMER_CALIBRATION_MS));
+    reference(end_ticks, end_time);
+
+    return (double) (end_ticks - begin_ticks) / (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count();
+    #else
+    return 1.0;
+    #endif
+}
+
+double cTimer::getTicksPerNs() {
+    static const double ticks_per_ns = calibrateTicksPerNs();
+    return ticks_per_ns;
+}
+
+uint64_t cTimer::getOverhead() {
+    // The minimum, rather than the mean, so that subtracting the overhead never removes part of the timed code's duration
+    static const uint64_t overhead = []() {
+        getTicksPerNs();
+        uint64_t min_ticks = UINT64_MAX;
+        for (uint32_t i = 0; i < TIMER_OVERHEAD_SAMPLES; i++) {
+            uint64_t begin = start();
+            uint64_t end = stop();
+            min_ticks = std::min(min_ticks, end - begin);
+        }
+        return min_ticks;
+    }();
+    return overhead;
+}
+
+bool cTimer::isInvariant() {
+    #if defined(__x86_64__) || defined(__i386__)
+    // CPUID leaf 0x80000007 (advanced power management), EDX bit 8: invariant TSC
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx >> 8) & 1;
+    #else
+    return true;
+    #endif
+}
+
+}
@@ -0,0 +1,186 @@
+/*
+ * This file is part of the Coyote <https://github.com/fpgasystems/Coyote>
+ *
+ * MIT Licence
+ * Copyright (c) 2025, Systems Group, ETH Zurich
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <map>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+#include <stdexcept>
+#include <sys/syscall.h>
+
+#include "cTrace.hpp"
+
+namespace coyote {
+
+const char* getTraceEventName(cTraceEvent event) {
+    switch (event) {
+        case cTraceEvent::INVOKE: return "invoke";
+        case cTraceEvent::POST_CMDS: return "postCmds";
+        case cTraceEvent::STALL: return "stall";
+        case cTraceEvent::COMPLETION: return "completion";
+        case cTraceEvent::WAIT: return "waitCompleted";
+        case cTraceEvent::GET_MEM: return "getMem";
+        case cTraceEvent::FREE_MEM: return "freeMem";
+        case cTraceEvent::USER_MAP: return "userMap";
+        case cTraceEvent::USER_UNMAP: return "userUnmap";
+        case cTraceEvent::RECONFIG: return "reconfigure";
+        case cTraceEvent::IRQ: return "irq";
+        default: return "unknown";
+    }
+}
+
+cTrace::cTrace() {
+    base_tsc = timestamp();
+}
+
+cTrace& cTrace::getInstance() {
+    static cTrace trace;
+    return trace;
+}
+
+cTraceBuffer& cTrace::getBuffer() {
+    // The buffer is shared with the tracer, so that it outlives the thread
+    thread_local std::shared_ptr<cTraceBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<cTraceBuffer>();
+        buffer->tid = static_cast<pid_t>(syscall(SYS_gettid));
+        buffer->records.reset(new cTraceRecord[TRACE_BUFFER_SIZE]);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void cTrace::record(cTraceEvent event, uint64_t begin, uint64_t end, int32_t ctid, uint64_t arg0, uint64_t arg1) {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    cTraceBuffer &buffer = getBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.records[head & (TRACE_BUFFER_SIZE - 1)] = { .begin = begin, .end = end, .event = event, .ctid = ctid, .arg0 = arg0, .arg1 = arg1 };
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void cTrace::setEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+void cTrace::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &buffer : buffers) {
+        buffer->head.store(0, std::memory_order_release);
+    }
+}
+
+std::vector<std::pair<pid_t, cTraceRecord>> cTrace::getRecords() {
+    std::vector<std::pair<pid_t, cTraceRecord>> records;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &buffer : buffers) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t first = head > TRACE_BUFFER_SIZE ? head - TRACE_BUFFER_SIZE : 0;
+        for (uint64_t i = first; i < head; i++) {
+            records.emplace_back(buffer->tid, buffer->records[i & (TRACE_BUFFER_SIZE - 1)]);
+        }
+    }
+
+    return records;
+}
+
+void cTrace::writeChrome(std::ostream &out) {
+    std::vector<std::pair<pid_t, cTraceRecord>> records = getRecords();
+    double ticks_per_ns = cTimer::getTicksPerNs();
+    pid_t pid = getpid();
+
+    // Timestamps in microseconds since the creation of the tracer, as expected by the format
+    auto to_us = [&](uint64_t tsc) {
+        return tsc > base_tsc ? (double) (tsc - base_tsc) / ticks_per_ns / 1e3 : 0.0;
+    };
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":\"Coyote\"}}";
+
+    // Operations in flight, from invoke to the first completion observed for their token, per cThread
+    std::map<std::pair<int32_t, uint64_t>, uint64_t> in_flight;
+
+    pid_t last_tid = 0;
+    for (auto &entry : records) {
+        pid_t tid = entry.first;
+        const cTraceRecord &rec = entry.second;
+
+        if (tid != last_tid) {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid;
+            out << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+            last_tid = tid;
+        }
+
+        out << ",\n{\"name\":\"" << getTraceEventName(rec.event) << "\",\"cat\":\"coyote\",\"pid\":" << pid << ",\"tid\":" << tid;
+        out << ",\"ts\":" << to_us(rec.begin);
+        if (rec.end != rec.begin) {
+            out << ",\"ph\":\"X\",\"dur\":" << to_us(rec.end) - to_us(rec.begin);
+        } else {
+            out << ",\"ph\":\"i\",\"s\":\"t\"";
+        }
+        out << ",\"args\":{\"ctid\":" << rec.ctid << ",\"arg0\":" << rec.arg0 << ",\"arg1\":" << rec.arg1 << "}}";
+
+        if (rec.event == cTraceEvent::INVOKE && rec.arg1 != 0) {
+            in_flight[{rec.ctid, rec.arg1}] = rec.end;
+        }
+    }
+
+    // The completions are matched after all invokes are known, since they may have been recorded by another thread
+    for (auto &entry : records) {
+        const cTraceRecord &rec = entry.second;
+        if (rec.event != cTraceEvent::COMPLETION) {
+            continue;
+        }
+
+        auto it = in_flight.find({rec.ctid, rec.arg1});
+        if (it == in_flight.end() || it->second > rec.begin) {
+            continue;
+        }
+
+        std::string name = "\"name\":\"DMA ctid " + std::to_string(rec.ctid) + "\",\"cat\":\"dma\",\"id\":\"" + std::to_string(rec.ctid) + ":" + std::to_string(rec.arg1) + "\"";
+        out << ",\n{" << name << ",\"ph\":\"b\",\"pid\":" << pid << ",\"ts\":" << to_us(it->second) << ",\"args\":{\"oper\":" << rec.arg0 << "}}";
+        out << ",\n{" << name << ",\"ph\":\"e\",\"pid\":" << pid << ",\"ts\":" << to_us(rec.begin) << "}";
+        in_flight.erase(it);
+    }
+
+    out << "]}" << std::endl;
+}
+
+void cTrace::writeChrome(const std::string &path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("ERROR: cTrace - could not open " + path + " for writing");
+    }
+    writeChrome(out);
+}
+
+}